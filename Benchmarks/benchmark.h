@@ -0,0 +1,66 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+
+namespace benchmark
+{
+
+// Measures elapsed wall-clock time since construction
+class timer
+{
+public:
+    timer() : m_start(std::chrono::steady_clock::now()) { }
+
+    double elapsed_ms() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// Prevents the compiler from optimizing away the computed value
+template<typename T>
+void do_not_optimize(const T& value)
+{
+#if defined(_MSC_VER)
+    static const void* volatile sink = nullptr;
+    sink = &value;
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+void vector_growth();
+void list_insert_erase();
+void queue_push_pop();
+void spsc_queue();
+void mpmc_queue();
+void lockfree_stack();
+void fork_join();
+
+}   // namespace benchmark
+
+#endif // BENCHMARK_H
@@ -0,0 +1,134 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#include "benchmark.h"
+#include "custom_thread_pool.h"
+#include "merge_sort.h"
+
+#include <random>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+namespace
+{
+
+constexpr int fib_cutoff = 20;
+constexpr std::ptrdiff_t sort_cutoff = 16384;
+
+long long fib(int n)
+{
+    return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+// Fork/join with very small tasks, it measures the overhead of the
+// scheduler. Below the cutoff the work is done sequentially.
+long long parallel_fib(course_l01::thread_pool& pool, int n)
+{
+    if (n < fib_cutoff)
+    {
+        return fib(n);
+    }
+
+    long long a = 0;
+    course_l01::task_group group(pool);
+    group.run([&pool, &a, n]() { a = parallel_fib(pool, n - 1); });
+    const long long b = parallel_fib(pool, n - 2);
+    group.wait();
+    return a + b;
+}
+
+// Halves are sorted in parallel and merged, small ranges are
+// sorted by the sequential merge sort from Course03.
+template<typename Iterator>
+void parallel_merge_sort(course_l01::thread_pool& pool, Iterator begin, Iterator end)
+{
+    if (end - begin < sort_cutoff)
+    {
+        course03::merge_sort(begin, end);
+        return;
+    }
+
+    Iterator middle = begin + (end - begin) / 2;
+    course_l01::task_group group(pool);
+    group.run([&pool, begin, middle]() { parallel_merge_sort(pool, begin, middle); });
+    parallel_merge_sort(pool, middle, end);
+    group.wait();
+    std::inplace_merge(begin, middle, end);
+}
+
+void print_result(const char* name, std::size_t threadCount, const benchmark::timer& timer)
+{
+    std::cout << "  " << std::left << std::setw(20) << name
+              << std::right
+              << " threads: " << std::setw(3) << threadCount
+              << " time ms: " << std::setw(8) << std::fixed << std::setprecision(2) << timer.elapsed_ms() << std::endl;
+}
+
+}   // namespace
+
+void benchmark::fork_join()
+{
+    constexpr int fibN = 36;
+    constexpr std::size_t sortCount = 4000000;
+    const std::size_t maxThreadCount = std::max(4u, std::thread::hardware_concurrency());
+
+    std::mt19937 generator(42);
+    std::vector<int> numbers(sortCount);
+    for (int& number : numbers)
+    {
+        number = static_cast<int>(generator());
+    }
+
+    std::cout << " fib(" << fibN << "), merge sort of " << sortCount << " numbers" << std::endl;
+
+    {
+        benchmark::timer timer;
+        benchmark::do_not_optimize(fib(fibN));
+        print_result("sequential fib", 0, timer);
+    }
+
+    {
+        std::vector<int> values = numbers;
+        benchmark::timer timer;
+        course03::merge_sort(values.begin(), values.end());
+        print_result("sequential sort", 0, timer);
+    }
+
+    for (std::size_t threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+    {
+        course_l01::thread_pool pool(threadCount);
+
+        {
+            benchmark::timer timer;
+            benchmark::do_not_optimize(parallel_fib(pool, fibN));
+            print_result("parallel fib", threadCount, timer);
+        }
+
+        {
+            std::vector<int> values = numbers;
+            benchmark::timer timer;
+            parallel_merge_sort(pool, values.begin(), values.end());
+            print_result("parallel sort", threadCount, timer);
+            benchmark::do_not_optimize(values.data());
+        }
+    }
+}
@@ -0,0 +1,71 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#include "benchmark.h"
+#include "custom_list.h"
+
+#include <list>
+#include <iostream>
+#include <iomanip>
+
+namespace
+{
+
+// Inserts and erases items at the front, at the back and in the middle
+// of a small list, which stays in the cache, so the time is dominated
+// by the relinking of the nodes in insert and erase.
+template<typename List>
+void run_insert_erase(const char* name, std::size_t count)
+{
+    List numbers(1000);
+    auto middle = std::next(numbers.begin(), numbers.size() / 2);
+    benchmark::timer timer;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const int value = static_cast<int>(i);
+
+        numbers.push_front(value);
+        numbers.push_back(value);
+        auto it = numbers.insert(middle, value);
+
+        numbers.erase(it);
+        numbers.pop_back();
+        numbers.pop_front();
+    }
+
+    benchmark::do_not_optimize(numbers.size());
+
+    std::cout << "  " << std::left << std::setw(20) << name
+              << std::right
+              << " time ms: " << std::setw(8) << std::fixed << std::setprecision(2) << timer.elapsed_ms() << std::endl;
+}
+
+}   // namespace
+
+void benchmark::list_insert_erase()
+{
+    for (std::size_t count : { 100000, 1000000, 10000000 })
+    {
+        std::cout << " " << count << " rounds of 3 inserts and 3 erases" << std::endl;
+        run_insert_erase<std::list<int>>("std::list", count);
+        run_insert_erase<course_l01::list<int>>("list", count);
+        run_insert_erase<course_l01::pooled_list<int>>("pooled_list", count);
+    }
+}
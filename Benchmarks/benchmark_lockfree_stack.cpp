@@ -0,0 +1,115 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#include "benchmark.h"
+#include "custom_stack.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+namespace
+{
+
+// Stack protected by a mutex, it has the same interface as lockfree_stack
+class locked_stack
+{
+public:
+    void push(int value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stack.push(value);
+    }
+
+    bool try_pop(int& value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stack.empty())
+            return false;
+
+        value = m_stack.top();
+        m_stack.pop();
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    course_l01::stack<int> m_stack;
+};
+
+// Threads take a buffer from the shared free list and return it,
+// like workers sharing a pool of buffers.
+template<typename Stack>
+void run_free_list(const char* name, std::size_t threadCount, std::size_t count)
+{
+    Stack stack;
+    for (int i = 0; i < 1024; ++i)
+    {
+        stack.push(i);
+    }
+
+    const std::size_t roundsPerThread = count / threadCount;
+    std::vector<std::thread> threads;
+    benchmark::timer timer;
+
+    for (std::size_t t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&stack, roundsPerThread]()
+        {
+            for (std::size_t i = 0; i < roundsPerThread; ++i)
+            {
+                int buffer = 0;
+                if (stack.try_pop(buffer))
+                {
+                    benchmark::do_not_optimize(buffer);
+                    stack.push(buffer);
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::cout << "  " << std::left << std::setw(20) << name
+              << std::right
+              << " threads: " << std::setw(3) << threadCount
+              << " time ms: " << std::setw(8) << std::fixed << std::setprecision(2) << timer.elapsed_ms() << std::endl;
+}
+
+}   // namespace
+
+void benchmark::lockfree_stack()
+{
+    constexpr std::size_t count = 4000000;
+    const std::size_t maxThreadCount = std::max(4u, std::thread::hardware_concurrency());
+
+    std::cout << " " << count << " pops and pushes of a free list" << std::endl;
+
+    for (std::size_t threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+    {
+        run_free_list<locked_stack>("mutex + stack", threadCount, count);
+        run_free_list<course_l01::lockfree_stack<int>>("lockfree_stack", threadCount, count);
+    }
+}
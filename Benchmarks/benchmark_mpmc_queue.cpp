@@ -0,0 +1,129 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#include "benchmark.h"
+#include "custom_queue.h"
+#include "custom_mpmc_queue.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+namespace
+{
+
+// Queue protected by a mutex, it has the same interface as mpmc_queue
+class locked_queue
+{
+public:
+    void push(int value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push(value);
+    }
+
+    void pop(int& value)
+    {
+        for (;;)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_queue.empty())
+                {
+                    value = m_queue.front();
+                    m_queue.pop();
+                    return;
+                }
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    course_l01::queue<int> m_queue;
+};
+
+// Each of threadCount producers pushes its share of count items and each
+// of threadCount consumers pops the same number of items, so all threads
+// contend on the queue all the time.
+template<typename Queue>
+void run_fan_in(const char* name, Queue& queue, std::size_t threadCount, std::size_t count)
+{
+    const std::size_t itemsPerThread = count / threadCount;
+    std::vector<std::thread> threads;
+    std::vector<long long> sums(threadCount, 0);
+    benchmark::timer timer;
+
+    for (std::size_t t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&queue, itemsPerThread]()
+        {
+            for (std::size_t i = 0; i < itemsPerThread; ++i)
+            {
+                queue.push(static_cast<int>(i));
+            }
+        });
+
+        threads.emplace_back([&queue, &sum = sums[t], itemsPerThread]()
+        {
+            for (std::size_t i = 0; i < itemsPerThread; ++i)
+            {
+                int value = 0;
+                queue.pop(value);
+                sum += value;
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    benchmark::do_not_optimize(sums);
+
+    std::cout << "  " << std::left << std::setw(20) << name
+              << std::right
+              << " threads: " << std::setw(3) << threadCount
+              << " time ms: " << std::setw(8) << std::fixed << std::setprecision(2) << timer.elapsed_ms() << std::endl;
+}
+
+}   // namespace
+
+void benchmark::mpmc_queue()
+{
+    constexpr std::size_t count = 4000000;
+    const std::size_t maxThreadCount = std::max(4u, std::thread::hardware_concurrency());
+
+    std::cout << " " << count << " items through the queue, threads: N producers and N consumers" << std::endl;
+
+    for (std::size_t threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+    {
+        locked_queue lockedQueue;
+        course_l01::mpmc_queue<int> mpmcQueue(1024);
+
+        run_fan_in("mutex + queue", lockedQueue, threadCount, count);
+        run_fan_in("mpmc_queue", mpmcQueue, threadCount, count);
+    }
+}
@@ -0,0 +1,74 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#include "benchmark.h"
+#include "custom_queue.h"
+#include "custom_list.h"
+
+#include <queue>
+#include <iostream>
+#include <iomanip>
+
+namespace
+{
+
+// Pushes a burst of items into the queue and pops them again, like
+// a work queue does. Queue holds up to 1000 items, so the buffer of
+// the ring buffer is reused and only the list allocates in the loop.
+template<typename Queue>
+void run_push_pop(const char* name, std::size_t count)
+{
+    Queue queue;
+    long long sum = 0;
+    benchmark::timer timer;
+
+    for (std::size_t i = 0; i < count; i += 1000)
+    {
+        for (std::size_t j = 0; j < 1000; ++j)
+        {
+            queue.push(static_cast<int>(i + j));
+        }
+
+        while (!queue.empty())
+        {
+            sum += queue.front();
+            queue.pop();
+        }
+    }
+
+    benchmark::do_not_optimize(sum);
+
+    std::cout << "  " << std::left << std::setw(20) << name
+              << std::right
+              << " time ms: " << std::setw(8) << std::fixed << std::setprecision(2) << timer.elapsed_ms() << std::endl;
+}
+
+}   // namespace
+
+void benchmark::queue_push_pop()
+{
+    for (std::size_t count : { 1000000, 10000000, 100000000 })
+    {
+        std::cout << " " << count << " pushes and pops" << std::endl;
+        run_push_pop<std::queue<int>>("std::queue", count);
+        run_push_pop<course_l01::queue<int, course_l01::list<int>>>("queue<list>", count);
+        run_push_pop<course_l01::queue<int, course_l01::pooled_list<int>>>("queue<pooled_list>", count);
+        run_push_pop<course_l01::queue<int>>("queue<ring_buffer>", count);
+    }
+}
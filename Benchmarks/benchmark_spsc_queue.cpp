@@ -0,0 +1,170 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#include "benchmark.h"
+#include "custom_queue.h"
+#include "custom_spsc_queue.h"
+
+#include <mutex>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+
+namespace
+{
+
+void print_result(const char* name, const benchmark::timer& timer)
+{
+    std::cout << "  " << std::left << std::setw(20) << name
+              << std::right
+              << " time ms: " << std::setw(8) << std::fixed << std::setprecision(2) << timer.elapsed_ms() << std::endl;
+}
+
+// Producer thread hands count items to the consumer (calling thread)
+// through a queue protected by a mutex.
+void run_mutex_queue(std::size_t count)
+{
+    course_l01::queue<int> queue;
+    std::mutex mutex;
+    long long sum = 0;
+    benchmark::timer timer;
+
+    std::thread producer([&]()
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push(static_cast<int>(i));
+        }
+    });
+
+    for (std::size_t received = 0; received < count;)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!queue.empty())
+        {
+            sum += queue.front();
+            queue.pop();
+            ++received;
+        }
+    }
+
+    producer.join();
+    benchmark::do_not_optimize(sum);
+    print_result("mutex + queue", timer);
+}
+
+void run_spsc_queue(std::size_t count)
+{
+    course_l01::spsc_queue<int> queue(1024);
+    long long sum = 0;
+    benchmark::timer timer;
+
+    std::thread producer([&]()
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            queue.push(static_cast<int>(i));
+        }
+    });
+
+    for (std::size_t received = 0; received < count;)
+    {
+        int value = 0;
+        if (queue.try_pop(value))
+        {
+            sum += value;
+            ++received;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    benchmark::do_not_optimize(sum);
+    print_result("spsc_queue", timer);
+}
+
+void run_spsc_queue_batched(std::size_t count)
+{
+    constexpr std::size_t batchSize = 64;
+    course_l01::spsc_queue<int> queue(1024);
+    long long sum = 0;
+    benchmark::timer timer;
+
+    std::thread producer([&]()
+    {
+        int batch[batchSize];
+        for (std::size_t i = 0; i < count;)
+        {
+            const std::size_t size = std::min(batchSize, count - i);
+            for (std::size_t j = 0; j < size; ++j)
+            {
+                batch[j] = static_cast<int>(i + j);
+            }
+
+            for (std::size_t pushed = 0; pushed < size;)
+            {
+                const std::size_t n = queue.try_push_n(batch + pushed, size - pushed);
+                if (n == 0)
+                {
+                    std::this_thread::yield();
+                }
+                pushed += n;
+            }
+
+            i += size;
+        }
+    });
+
+    int batch[batchSize];
+    for (std::size_t received = 0; received < count;)
+    {
+        const std::size_t n = queue.try_pop_n(batch, batchSize);
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            sum += batch[j];
+        }
+
+        if (n == 0)
+        {
+            std::this_thread::yield();
+        }
+        received += n;
+    }
+
+    producer.join();
+    benchmark::do_not_optimize(sum);
+    print_result("spsc_queue batched", timer);
+}
+
+}   // namespace
+
+void benchmark::spsc_queue()
+{
+    for (std::size_t count : { 1000000, 10000000 })
+    {
+        std::cout << " " << count << " items from producer to consumer" << std::endl;
+        run_mutex_queue(count);
+        run_spsc_queue(count);
+        run_spsc_queue_batched(count);
+    }
+}
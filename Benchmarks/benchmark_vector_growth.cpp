@@ -0,0 +1,111 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+
+#include "benchmark.h"
+#include "custom_vector.h"
+
+#include <iostream>
+#include <iomanip>
+
+namespace
+{
+
+struct allocation_statistics
+{
+    std::size_t allocations = 0;
+    std::size_t allocatedBytes = 0;
+    std::size_t peakBytes = 0;
+};
+
+// Allocator, which counts the allocations and tracks the peak
+// of the allocated memory (which is what drives peak RSS).
+template<typename T>
+class counting_allocator
+{
+public:
+    using value_type = T;
+
+    counting_allocator(allocation_statistics* statistics) : m_statistics(statistics) { }
+    template<typename U>
+    counting_allocator(const counting_allocator<U>& other) : m_statistics(other.get_statistics()) { }
+
+    T* allocate(std::size_t n)
+    {
+        ++m_statistics->allocations;
+        m_statistics->allocatedBytes += n * sizeof(T);
+        m_statistics->peakBytes = std::max(m_statistics->peakBytes, m_statistics->allocatedBytes);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        m_statistics->allocatedBytes -= n * sizeof(T);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    allocation_statistics* get_statistics() const { return m_statistics; }
+
+    bool operator==(const counting_allocator& other) const { return m_statistics == other.m_statistics; }
+    bool operator!=(const counting_allocator& other) const { return m_statistics != other.m_statistics; }
+
+private:
+    allocation_statistics* m_statistics = nullptr;
+};
+
+template<typename GrowthPolicy>
+void run_growth_policy(const char* name, std::size_t count)
+{
+    allocation_statistics statistics;
+    benchmark::timer timer;
+
+    {
+        counting_allocator<int> allocator(&statistics);
+        course_l01::vector<int, counting_allocator<int>, GrowthPolicy> numbers(allocator);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            numbers.push_back(static_cast<int>(i));
+        }
+
+        benchmark::do_not_optimize(numbers.data());
+
+        std::cout << "  " << std::left << std::setw(12) << name
+                  << std::right
+                  << " reallocations: " << std::setw(4) << statistics.allocations
+                  << "  peak MB: " << std::setw(8) << std::fixed << std::setprecision(2) << statistics.peakBytes / (1024.0 * 1024.0)
+                  << "  final MB: " << std::setw(8) << numbers.capacity() * sizeof(int) / (1024.0 * 1024.0)
+                  << "  time ms: " << std::setw(8) << timer.elapsed_ms() << std::endl;
+    }
+}
+
+}   // namespace
+
+void benchmark::vector_growth()
+{
+    // Peak memory is the sum of the old and the new block during
+    // the reallocation, which is usually the peak RSS of the process.
+    for (std::size_t count : { 1000000, 10000000, 50000000 })
+    {
+        std::cout << " " << count << " items pushed back" << std::endl;
+        run_growth_policy<course_l01::doubling_growth_policy>("doubling", count);
+        run_growth_policy<course_l01::one_and_half_growth_policy>("1.5x", count);
+        run_growth_policy<course_l01::size_class_growth_policy>("size class", count);
+    }
+}
@@ -0,0 +1,61 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+
+#include "benchmark.h"
+
+#include <iostream>
+#include <string>
+#include <functional>
+#include <utility>
+
+int main(int argc, char** argv)
+{
+    // Benchmarks can be selected by name on the command line,
+    // if no name is given, all benchmarks are run.
+    const std::pair<const char*, std::function<void()>> benchmarks[] =
+    {
+        { "vector_growth", benchmark::vector_growth },
+        { "list_insert_erase", benchmark::list_insert_erase },
+        { "queue_push_pop", benchmark::queue_push_pop },
+        { "spsc_queue", benchmark::spsc_queue },
+        { "mpmc_queue", benchmark::mpmc_queue },
+        { "lockfree_stack", benchmark::lockfree_stack },
+        { "fork_join", benchmark::fork_join },
+    };
+
+    for (const auto& [name, function] : benchmarks)
+    {
+        bool run = argc < 2;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            run = run || std::string(argv[i]) == name;
+        }
+
+        if (run)
+        {
+            std::cout << "Benchmark " << name << std::endl;
+            function();
+            std::cout << std::endl;
+        }
+    }
+
+    return 0;
+}
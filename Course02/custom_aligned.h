@@ -0,0 +1,102 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+
+#ifndef CUSTOM_ALIGNED_H
+#define CUSTOM_ALIGNED_H
+
+#include <new>
+#include <memory>
+#include <cstddef>
+#include <type_traits>
+
+namespace course_l01
+{
+
+// Size of the cache line. Data written by different threads are aligned
+// to it, so the threads don't invalidate each other's cache lines (false
+// sharing). std::hardware_destructive_interference_size is not used,
+// because its value is not stable across compiler flags.
+inline constexpr std::size_t cache_line_size = 64;
+
+// Tells the compiler, that the pointer is aligned to Alignment bytes,
+// so it can use aligned SIMD loads and stores. Behaviour is undefined,
+// if the pointer is not aligned.
+template<std::size_t Alignment, typename T>
+inline T* assume_aligned(T* ptr) noexcept
+{
+    static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two.");
+
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<T*>(__builtin_assume_aligned(ptr, Alignment));
+#else
+    return ptr;
+#endif
+}
+
+// Allocator, which allocates memory aligned to Alignment bytes (for example
+// to the cache line or to the width of SIMD register), or to the alignment
+// of the type, if it is greater.
+template<typename T, std::size_t Alignment = cache_line_size>
+class aligned_allocator
+{
+public:
+    using value_type = T;
+
+    static constexpr std::size_t alignment = Alignment < alignof(T) ? alignof(T) : Alignment;
+    static_assert((alignment & (alignment - 1)) == 0, "Alignment must be a power of two.");
+
+    template<typename U>
+    struct rebind { using other = aligned_allocator<U, Alignment>; };
+
+    aligned_allocator() noexcept = default;
+    template<typename U>
+    aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept { }
+
+    T* allocate(std::size_t n)
+    {
+        if (n > static_cast<std::size_t>(-1) / sizeof(T))
+            throw std::bad_array_new_length();
+
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept
+    {
+        ::operator delete(p, std::align_val_t(alignment));
+    }
+
+    bool operator==(const aligned_allocator&) const noexcept { return true; }
+    bool operator!=(const aligned_allocator&) const noexcept { return false; }
+};
+
+// Alignment guaranteed by the allocator. It is the alignment of the type for
+// the ordinary allocators, aligned allocator guarantees its own alignment.
+template<typename Allocator, typename = void>
+struct allocator_alignment : std::integral_constant<std::size_t, alignof(typename std::allocator_traits<Allocator>::value_type)> { };
+
+template<typename Allocator>
+struct allocator_alignment<Allocator, std::void_t<decltype(Allocator::alignment)>> : std::integral_constant<std::size_t, Allocator::alignment> { };
+
+template<typename Allocator>
+inline constexpr std::size_t allocator_alignment_v = allocator_alignment<Allocator>::value;
+
+}   // namespace course_l01
+
+#endif // CUSTOM_ALIGNED_H
@@ -22,11 +22,16 @@
 
 #include <stdexcept>
 #include <iterator>
+#include <algorithm>
+
+#include "custom_aligned.h"
 
 namespace course_l01
 {
 
-template<typename T, size_t N>
+// Array, whose data can be aligned to Alignment bytes (for example to
+// the width of SIMD registers, or to the cache line).
+template<typename T, size_t N, size_t Alignment = alignof(T)>
 class array
 {
 public:
@@ -64,6 +69,11 @@ public:
     pointer data() noexcept { return m_data; }
     const_pointer data() const noexcept { return m_data; }
 
+    // Same as data(), but the compiler is told, that the data are aligned
+    static constexpr size_type alignment = Alignment;
+    pointer aligned_data() noexcept { return assume_aligned<Alignment>(m_data); }
+    const_pointer aligned_data() const noexcept { return assume_aligned<Alignment>(m_data); }
+
     // Iterators
 
     iterator begin() noexcept { return m_data; }
@@ -83,13 +93,15 @@ public:
     const_reverse_iterator crend() const noexcept { return std::make_reverse_iterator(cbegin()); }
 
     void fill(const value_type& val) { std::fill(begin(), end(), val); }
-    void swap(const array<T, N>& other) { std::swap(*this, other); }
+    void swap(const array<T, N, Alignment>& other) { std::swap(*this, other); }
+
+    static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two, at least the alignment of the type.");
 
-    T m_data[N];
+    alignas(Alignment) T m_data[N];
 };
 
-template<typename T, size_t N>
-typename array<T, N>::reference array<T, N>::at(size_type pos)
+template<typename T, size_t N, size_t Alignment>
+typename array<T, N, Alignment>::reference array<T, N, Alignment>::at(size_type pos)
 {
     if (!(pos < size()))
         throw std::out_of_range("array<T>::at - index is out of range.");
@@ -97,8 +109,8 @@ typename array<T, N>::reference array<T, N>::at(size_type pos)
     return m_data[pos];
 }
 
-template<typename T, size_t N>
-typename array<T, N>::const_reference array<T, N>::at(size_type pos) const
+template<typename T, size_t N, size_t Alignment>
+typename array<T, N, Alignment>::const_reference array<T, N, Alignment>::at(size_type pos) const
 {
     if (!(pos < size()))
         throw std::out_of_range("array<T>::at - index is out of range.");
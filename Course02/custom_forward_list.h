@@ -0,0 +1,712 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#ifndef CUSTOM_FORWARD_LIST_H
+#define CUSTOM_FORWARD_LIST_H
+
+#include <iterator>
+#include <memory>
+#include <functional>
+#include <utility>
+
+#include "custom_pool_allocator.h"
+#include "custom_node_sort.h"
+
+namespace course_l01
+{
+
+// Singly linked list. Nodes have only the pointer to the next node,
+// so they are smaller than the nodes of the list. Unlike std::forward_list,
+// the list keeps its size and the pointer to the last node, so it supports
+// push_back and back and can be used as a container of the queue.
+template<typename T, typename Allocator = std::allocator<T>>
+class forward_list
+{
+private:
+    struct _node_base;
+    struct _node;
+    using node_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<_node>;
+
+public:
+    // Type declarations
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    forward_list() = default;
+    explicit forward_list( const Allocator& alloc ) : m_allocator(alloc) { }
+    explicit forward_list( size_type count, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { resize(count); }
+    template< class InputIt >
+    forward_list( InputIt first, InputIt last, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { append(first, last); }
+    forward_list( const forward_list& other ) : m_allocator(std::allocator_traits<node_allocator_type>::select_on_container_copy_construction(other.m_allocator)) { append(other.begin(), other.end()); }
+    forward_list( forward_list&& other ) : m_allocator(other.m_allocator) { swap_nodes(other); }
+    forward_list( std::initializer_list<T> init, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { append(init.begin(), init.end()); }
+    ~forward_list() { clear(); }
+
+    // Assignment operator
+    forward_list& operator=( const forward_list& other );
+    forward_list& operator=( forward_list&& other );
+
+    // Assign methods
+    void assign( size_type count, const T& value ) { clear(); insert_after(before_begin(), count, value); }
+    template< class InputIt, std::enable_if_t<std::is_same_v<T, typename std::iterator_traits<InputIt>::value_type>, int> = 0 >
+    void assign( InputIt first, InputIt last ) { clear(); append(first, last); }
+    void assign( std::initializer_list<T> ilist ) { assign(ilist.begin(), ilist.end()); }
+
+    template<typename Value>
+    class _iterator
+    {
+    public:
+        using value_type = Value;
+        using reference = Value&;
+        using pointer = Value*;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        _iterator() = default;
+        explicit _iterator(_node_base* node) : m_node(node) {}
+
+        reference operator*() const { return as_node(m_node)->value; }
+        pointer operator->() const { return &as_node(m_node)->value; }
+        _iterator& operator++() { m_node = m_node->next; return *this; }
+        _iterator operator++(int) { _iterator temp = *this; ++(*this); return temp; }
+
+        bool operator==(const _iterator& other) const { return m_node == other.m_node; }
+        bool operator!=(const _iterator& other) const { return !(*this == other); }
+
+        operator _iterator<const T>() const { return _iterator<const T>(m_node); }
+
+    private:
+        friend class forward_list;
+
+        _node_base* m_node = nullptr;
+    };
+
+    using iterator = _iterator<value_type>;
+    using const_iterator = _iterator<const value_type>;
+
+    // Element access
+
+    reference front() noexcept { return as_node(m_head.next)->value; }
+    const_reference front() const noexcept { return as_node(m_head.next)->value; }
+
+    reference back() noexcept { return as_node(m_tail)->value; }
+    const_reference back() const noexcept { return as_node(m_tail)->value; }
+
+    // Iterators
+
+    iterator before_begin() noexcept { return iterator(&m_head); }
+    const_iterator before_begin() const noexcept { return const_iterator(const_cast<_node_base*>(&m_head)); }
+    const_iterator cbefore_begin() const noexcept { return before_begin(); }
+
+    iterator begin() noexcept { return iterator(m_head.next); }
+    const_iterator begin() const noexcept { return const_iterator(m_head.next); }
+    const_iterator cbegin() const noexcept { return const_iterator(m_head.next); }
+
+    iterator end() noexcept { return iterator(nullptr); }
+    const_iterator end() const noexcept { return const_iterator(nullptr); }
+    const_iterator cend() const noexcept { return const_iterator(nullptr); }
+
+    // Capacity methods
+    bool empty() const noexcept { return m_size == 0; }
+    size_type size() const noexcept { return m_size; }
+    size_type max_size() const noexcept { return std::allocator_traits<node_allocator_type>::max_size(m_allocator); }
+
+    // Modifiers
+    void clear() noexcept;
+    void swap( forward_list& other );
+
+    void push_front( const value_type& item ) { link_after(&m_head, construct(item)); }
+    void push_front( value_type&& item ) { link_after(&m_head, construct(std::move(item))); }
+    void push_back( const value_type& item ) { link_after(m_tail, construct(item)); }
+    void push_back( value_type&& item ) { link_after(m_tail, construct(std::move(item))); }
+
+    void pop_front() { erase_after(before_begin()); }
+
+    void resize( size_type count ) { resize(count, value_type()); }
+    void resize( size_type count, const value_type& value );
+
+    // Insert
+    iterator insert_after( const_iterator pos, const T& value ) { return link_after(pos.m_node, construct(value)); }
+    iterator insert_after( const_iterator pos, T&& value ) { return link_after(pos.m_node, construct(std::move(value))); }
+    iterator insert_after( const_iterator pos, size_type count, const T& value );
+    template<class InputIt, std::enable_if_t<std::is_same_v<T, typename std::remove_const<typename std::iterator_traits<InputIt>::value_type>::type>, int> = 0>
+    iterator insert_after( const_iterator pos, InputIt first, InputIt last );
+    iterator insert_after( const_iterator pos, std::initializer_list<T> ilist ) { return insert_after(pos, ilist.begin(), ilist.end()); }
+
+    // Erase
+    iterator erase_after( const_iterator pos );
+    iterator erase_after( const_iterator first, const_iterator last );
+
+    // Emplace
+    template<typename... Args>
+    reference emplace_front( Args&&... args ) { return *link_after(&m_head, construct(std::forward<Args>(args)...)); }
+    template<typename... Args>
+    reference emplace_back( Args&&... args ) { return *link_after(m_tail, construct(std::forward<Args>(args)...)); }
+    template< class... Args >
+    iterator emplace_after( const_iterator pos, Args&&... args ) { return link_after(pos.m_node, construct(std::forward<Args>(args)...)); }
+
+    // Splice, moves the items after the position pos
+    void splice_after( const_iterator pos, forward_list& other ) { splice_after_impl(pos, other); }
+    void splice_after( const_iterator pos, forward_list&& other ) { splice_after_impl(pos, other); }
+    void splice_after( const_iterator pos, forward_list& other, const_iterator it ) { splice_after_impl(pos, other, it, std::next(it, 2)); }
+    void splice_after( const_iterator pos, forward_list&& other, const_iterator it ) { splice_after_impl(pos, other, it, std::next(it, 2)); }
+    void splice_after( const_iterator pos, forward_list& other, const_iterator first, const_iterator last ) { splice_after_impl(pos, other, first, last); }
+    void splice_after( const_iterator pos, forward_list&& other, const_iterator first, const_iterator last ) { splice_after_impl(pos, other, first, last); }
+
+    // Merge
+    void merge( forward_list& other ) { merge(other, std::less<T>()); }
+    void merge( forward_list&& other ) { merge(other, std::less<T>()); }
+    template<typename Comparator>
+    void merge( forward_list& other, Comparator comp ) { merge_impl(other, comp); }
+    template<typename Comparator>
+    void merge( forward_list&& other, Comparator comp ) { merge_impl(other, comp); }
+
+    // Sort
+    void sort() { sort(std::less<T>()); }
+    template<typename Comparator>
+    void sort( Comparator comp );
+
+    // Remove
+    size_type remove( const T& value ) { return remove_impl([&value](const T& v) { return v == value; }); }
+    template<typename UnaryPredicate>
+    size_type remove( UnaryPredicate comp ) { return remove_impl(comp); }
+
+    // Reverse
+    void reverse() noexcept;
+
+    // Unique
+    size_type unique() { return unique([](const auto& l, const auto& r) { return l == r; }); }
+    template< class BinaryPredicate >
+    size_type unique( BinaryPredicate p );
+
+    allocator_type get_allocator() const { return allocator_type(m_allocator); }
+
+private:
+
+    // Head is the node before the first node, it makes
+    // insertion at the start of the list same as any other.
+    struct _node_base
+    {
+        _node_base* next = nullptr;
+    };
+
+    struct _node : public _node_base
+    {
+        template<typename... Args>
+        _node( Args&&... args ) : value(std::forward<Args>(args)...) { }
+
+        T value;
+    };
+
+    static _node* as_node( _node_base* node ) noexcept { return static_cast<_node*>(node); }
+
+    template<typename... Args>
+    _node* construct( Args&&... args );
+    void destroy( _node* node ) noexcept;
+    void swap_nodes( forward_list& other ) noexcept;
+    void reset_tail() noexcept;
+
+    template<class InputIt>
+    void append( InputIt first, InputIt last );
+
+    iterator link_after( _node_base* pos, _node* node ) noexcept;
+    void splice_after_impl( const_iterator pos, forward_list& other );
+    void splice_after_impl( const_iterator pos, forward_list& other, const_iterator first, const_iterator last );
+    iterator unconst_iterator( const_iterator it ) { return iterator(it.m_node); }
+
+    template<typename Comparator>
+    void merge_impl( forward_list& other, Comparator comp );
+
+    // Restores the list from the null terminated chain after sorting
+    void relink_nodes( _node_base* chain ) noexcept;
+
+    template<typename UnaryPredicate>
+    size_type remove_impl( UnaryPredicate comp );
+
+    node_allocator_type m_allocator;
+    _node_base m_head;
+    _node_base* m_tail = &m_head;
+    size_type m_size = 0;
+};
+
+// Forward list, whose nodes are allocated from the node pool
+template<typename T>
+using pooled_forward_list = forward_list<T, pool_allocator<T>>;
+
+template<typename T, typename Allocator>
+forward_list<T, Allocator>& forward_list<T, Allocator>::operator=( const forward_list& other )
+{
+    if (this == &other)
+        return *this;
+
+    // All nodes are released before the allocator is propagated,
+    // they must be released by the allocator which allocated them.
+    clear();
+
+    if constexpr (std::allocator_traits<node_allocator_type>::propagate_on_container_copy_assignment::value)
+    {
+        m_allocator = other.m_allocator;
+    }
+
+    append(other.begin(), other.end());
+    return *this;
+}
+
+template<typename T, typename Allocator>
+forward_list<T, Allocator>& forward_list<T, Allocator>::operator=( forward_list&& other )
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    if constexpr (std::allocator_traits<node_allocator_type>::propagate_on_container_move_assignment::value)
+    {
+        m_allocator = other.m_allocator;
+        swap_nodes(other);
+    }
+    else if (m_allocator == other.m_allocator)
+    {
+        swap_nodes(other);
+    }
+    else
+    {
+        // We can't release the nodes of the other list, so move the items
+        append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    }
+
+    return *this;
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+typename forward_list<T, Allocator>::_node* forward_list<T, Allocator>::construct( Args&&... args )
+{
+    _node* node = std::allocator_traits<node_allocator_type>::allocate(m_allocator, 1);
+
+    try
+    {
+        std::allocator_traits<node_allocator_type>::construct(m_allocator, node, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        std::allocator_traits<node_allocator_type>::deallocate(m_allocator, node, 1);
+        throw;
+    }
+
+    return node;
+}
+
+template<typename T, typename Allocator>
+void forward_list<T, Allocator>::destroy( _node* node ) noexcept
+{
+    std::allocator_traits<node_allocator_type>::destroy(m_allocator, node);
+    std::allocator_traits<node_allocator_type>::deallocate(m_allocator, node, 1);
+}
+
+template<typename T, typename Allocator>
+void forward_list<T, Allocator>::swap_nodes( forward_list& other ) noexcept
+{
+    std::swap(m_head.next, other.m_head.next);
+    std::swap(m_tail, other.m_tail);
+    std::swap(m_size, other.m_size);
+
+    // Tail of the empty list points to its own head
+    reset_tail();
+    other.reset_tail();
+}
+
+template<typename T, typename Allocator>
+void forward_list<T, Allocator>::reset_tail() noexcept
+{
+    if (m_size == 0)
+    {
+        m_tail = &m_head;
+    }
+}
+
+template<typename T, typename Allocator>
+void forward_list<T, Allocator>::clear() noexcept
+{
+    _node_base* node = m_head.next;
+    while (node)
+    {
+        _node_base* next = node->next;
+        destroy(as_node(node));
+        node = next;
+    }
+
+    m_head.next = nullptr;
+    m_tail = &m_head;
+    m_size = 0;
+}
+
+template<typename T, typename Allocator>
+void forward_list<T, Allocator>::swap( forward_list& other )
+{
+    swap_nodes(other);
+
+    if constexpr (std::allocator_traits<node_allocator_type>::propagate_on_container_swap::value)
+    {
+        std::swap(m_allocator, other.m_allocator);
+    }
+}
+
+template<typename T, typename Allocator>
+void forward_list<T, Allocator>::resize( size_type count, const value_type& value )
+{
+    if (count < size())
+    {
+        erase_after(std::next(before_begin(), count), end());
+    }
+    else
+    {
+        insert_after(const_iterator(m_tail), count - size(), value);
+    }
+}
+
+template<typename T, typename Allocator>
+typename forward_list<T, Allocator>::iterator forward_list<T, Allocator>::insert_after( const_iterator pos, size_type count, const T& value )
+{
+    for (size_type i = 0; i < count; ++i)
+    {
+        pos = insert_after(pos, value);
+    }
+
+    return unconst_iterator(pos);
+}
+
+template<typename T, typename Allocator>
+template<class InputIt, std::enable_if_t<std::is_same_v<T, typename std::remove_const<typename std::iterator_traits<InputIt>::value_type>::type>, int>>
+typename forward_list<T, Allocator>::iterator forward_list<T, Allocator>::insert_after( const_iterator pos, InputIt first, InputIt last )
+{
+    for (; first != last; ++first)
+    {
+        pos = insert_after(pos, *first);
+    }
+
+    return unconst_iterator(pos);
+}
+
+template<typename T, typename Allocator>
+template<class InputIt>
+void forward_list<T, Allocator>::append( InputIt first, InputIt last )
+{
+    for (; first != last; ++first)
+    {
+        link_after(m_tail, construct(*first));
+    }
+}
+
+template<typename T, typename Allocator>
+typename forward_list<T, Allocator>::iterator forward_list<T, Allocator>::link_after( _node_base* pos, _node* node ) noexcept
+{
+    node->next = pos->next;
+    pos->next = node;
+
+    if (pos == m_tail)
+    {
+        m_tail = node;
+    }
+
+    ++m_size;
+    return iterator(node);
+}
+
+template<typename T, typename Allocator>
+typename forward_list<T, Allocator>::iterator forward_list<T, Allocator>::erase_after( const_iterator pos )
+{
+    _node_base* prev = pos.m_node;
+    _node_base* node = prev->next;
+    prev->next = node->next;
+
+    if (node == m_tail)
+    {
+        m_tail = prev;
+    }
+
+    --m_size;
+    destroy(as_node(node));
+    return iterator(prev->next);
+}
+
+template<typename T, typename Allocator>
+typename forward_list<T, Allocator>::iterator forward_list<T, Allocator>::erase_after( const_iterator first, const_iterator last )
+{
+    _node_base* prev = first.m_node;
+
+    while (prev->next != last.m_node)
+    {
+        erase_after(first);
+    }
+
+    return unconst_iterator(last);
+}
+
+template<typename T, typename Allocator>
+void forward_list<T, Allocator>::splice_after_impl( const_iterator pos, forward_list& other )
+{
+    if (this == &other || other.empty())
+        return;
+
+    if (m_allocator != other.m_allocator)
+    {
+        // Our allocator can't release nodes of the other list,
+        // so the items must be moved into new nodes.
+        insert_after(pos, std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        other.clear();
+        return;
+    }
+
+    // Whole list is relinked at once, we know its size and its last node
+    _node_base* prev = pos.m_node;
+    other.m_tail->next = prev->next;
+    prev->next = other.m_head.next;
+
+    if (prev == m_tail)
+    {
+        m_tail = other.m_tail;
+    }
+
+    m_size += other.m_size;
+
+    other.m_head.next = nullptr;
+    other.m_tail = &other.m_head;
+    other.m_size = 0;
+}
+
+template<typename T, typename Allocator>
+void forward_list<T, Allocator>::splice_after_impl( const_iterator pos, forward_list& other, const_iterator first, const_iterator last )
+{
+    // Items in the range (first, last) are moved after pos
+    _node_base* prev = pos.m_node;
+    _node_base* before = first.m_node;
+
+    if (before->next == last.m_node || prev == before)
+        return;
+
+    if (m_allocator != other.m_allocator)
+    {
+        insert_after(pos, std::make_move_iterator(other.unconst_iterator(std::next(first))), std::make_move_iterator(other.unconst_iterator(last)));
+        other.erase_after(first, last);
+        return;
+    }
+
+    // Last node of the range must be found, range is counted
+    // only if the items are moved between different lists.
+    _node_base* rangeFirst = before->next;
+    _node_base* rangeLast = rangeFirst;
+    size_type count = 1;
+
+    while (rangeLast->next != last.m_node)
+    {
+        rangeLast = rangeLast->next;
+        ++count;
+    }
+
+    if (prev == rangeLast)
+        return;
+
+    before->next = last.m_node;
+    if (rangeLast == other.m_tail)
+    {
+        other.m_tail = before;
+    }
+
+    rangeLast->next = prev->next;
+    prev->next = rangeFirst;
+    if (prev == m_tail)
+    {
+        m_tail = rangeLast;
+    }
+
+    if (this != &other)
+    {
+        other.m_size -= count;
+        m_size += count;
+    }
+}
+
+template<typename T, typename Allocator>
+template<typename Comparator>
+void forward_list<T, Allocator>::merge_impl( forward_list& other, Comparator comp )
+{
+    if (this == &other)
+        return;
+
+    if (m_allocator != other.m_allocator)
+    {
+        // Nodes can't be relinked, move the items into
+        // the list using our allocator and merge it.
+        forward_list temporary(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), get_allocator());
+        other.clear();
+        merge_impl(temporary, comp);
+        return;
+    }
+
+    _node_base* prev = &m_head;
+    while (prev->next && !other.empty())
+    {
+        if (comp(other.front(), as_node(prev->next)->value))
+        {
+            // Find the whole run of items from the other list, which
+            // belongs before the next node, and relink it at once.
+            _node_base* first = other.m_head.next;
+            _node_base* last = first;
+            size_type count = 1;
+
+            while (last->next && comp(as_node(last->next)->value, as_node(prev->next)->value))
+            {
+                last = last->next;
+                ++count;
+            }
+
+            other.m_head.next = last->next;
+            other.m_size -= count;
+            other.reset_tail();
+
+            last->next = prev->next;
+            prev->next = first;
+            m_size += count;
+            prev = last;
+        }
+
+        prev = prev->next;
+    }
+
+    splice_after_impl(const_iterator(m_tail), other);
+}
+
+template<typename T, typename Allocator>
+template<typename Comparator>
+void forward_list<T, Allocator>::sort( Comparator comp )
+{
+    if (size() < 2)
+        return;
+
+    // Chain is already terminated by null
+    _node_base* chain = m_head.next;
+
+    auto compareNodes = [&comp](_node_base* left, _node_base* right) { return comp(as_node(left)->value, as_node(right)->value); };
+
+    try
+    {
+        node_chain_sorter<_node_base>::sort(chain, compareNodes);
+    }
+    catch (...)
+    {
+        // Comparator has thrown, the chain contains all nodes again
+        relink_nodes(chain);
+        throw;
+    }
+
+    relink_nodes(chain);
+}
+
+template<typename T, typename Allocator>
+void forward_list<T, Allocator>::relink_nodes( _node_base* chain ) noexcept
+{
+    // Restore the head and find the new tail, size remains the same
+    m_head.next = chain;
+    m_tail = &m_head;
+    while (m_tail->next)
+    {
+        m_tail = m_tail->next;
+    }
+}
+
+template<typename T, typename Allocator>
+template<typename UnaryPredicate>
+typename forward_list<T, Allocator>::size_type forward_list<T, Allocator>::remove_impl( UnaryPredicate comp )
+{
+    size_type removedItems = 0;
+
+    for (auto it = before_begin(); std::next(it) != end();)
+    {
+        if (comp(*std::next(it)))
+        {
+            erase_after(it);
+            ++removedItems;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return removedItems;
+}
+
+template<typename T, typename Allocator>
+void forward_list<T, Allocator>::reverse() noexcept
+{
+    _node_base* node = m_head.next;
+    _node_base* reversed = nullptr;
+
+    // First node will be the last one
+    if (node)
+    {
+        m_tail = node;
+    }
+
+    while (node)
+    {
+        _node_base* next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+    }
+
+    m_head.next = reversed;
+}
+
+template<typename T, typename Allocator>
+template<class BinaryPredicate>
+typename forward_list<T, Allocator>::size_type forward_list<T, Allocator>::unique( BinaryPredicate p )
+{
+    if (empty())
+        return 0;
+
+    size_type removedItems = 0;
+
+    for (auto it = begin(); std::next(it) != end();)
+    {
+        if (p(*it, *std::next(it)))
+        {
+            erase_after(it);
+            ++removedItems;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return removedItems;
+}
+
+} // namespace course_l01
+
+#endif // CUSTOM_FORWARD_LIST_H
@@ -0,0 +1,799 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#ifndef CUSTOM_INDEXED_LIST_H
+#define CUSTOM_INDEXED_LIST_H
+
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+#include <cstdint>
+
+namespace course_l01
+{
+
+// Sequence container with stable iterators (like list), which also
+// supports positional access, insert and erase in O(log n). Items are
+// stored in nodes of an implicit treap: the tree is ordered by the position
+// of items and every node knows the size of its subtree, so the node
+// at a given index, or the index of a given node, is found in O(log n).
+// The tree is kept balanced by random node priorities (heap ordered).
+template<typename T, typename Allocator = std::allocator<T>>
+class indexed_list
+{
+private:
+    struct _node_base;
+    struct _node;
+    using node_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<_node>;
+
+public:
+    // Type declarations
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    indexed_list() = default;
+    explicit indexed_list( const Allocator& alloc ) : m_allocator(alloc) { }
+    explicit indexed_list( size_type count, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { resize(count); }
+    template< class InputIt >
+    indexed_list( InputIt first, InputIt last, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { insert(end(), first, last); }
+    indexed_list( const indexed_list& other ) : m_allocator(std::allocator_traits<node_allocator_type>::select_on_container_copy_construction(other.m_allocator)) { insert(end(), other.begin(), other.end()); }
+    indexed_list( indexed_list&& other ) : m_allocator(other.m_allocator) { swap_nodes(other); }
+    indexed_list( std::initializer_list<T> init, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { insert(end(), init.begin(), init.end()); }
+    ~indexed_list() { clear(); }
+
+    // Assignment operator
+    indexed_list& operator=( const indexed_list& other );
+    indexed_list& operator=( indexed_list&& other );
+
+    // Assign methods
+    void assign( size_type count, const T& value ) { clear(); insert(end(), count, value); }
+    template< class InputIt, std::enable_if_t<std::is_same_v<T, typename std::iterator_traits<InputIt>::value_type>, int> = 0 >
+    void assign( InputIt first, InputIt last ) { clear(); insert(end(), first, last); }
+    void assign( std::initializer_list<T> ilist ) { assign(ilist.begin(), ilist.end()); }
+
+    template<typename Value>
+    class _iterator
+    {
+    public:
+        using value_type = Value;
+        using reference = Value&;
+        using pointer = Value*;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        explicit _iterator(_node_base* node) : m_node(node) {}
+
+        reference operator*() const { return as_node(m_node)->value; }
+        pointer operator->() const { return &as_node(m_node)->value; }
+        _iterator& operator++() { m_node = next_node(m_node); return *this; }
+        _iterator operator++(int) { _iterator temp = *this; ++(*this); return temp; }
+        _iterator& operator--() { m_node = prev_node(m_node); return *this; }
+        _iterator operator--(int) { _iterator temp = *this; --(*this); return temp; }
+
+        bool operator==(const _iterator& other) const { return m_node == other.m_node; }
+        bool operator!=(const _iterator& other) const { return !(*this == other); }
+
+        operator _iterator<const T>() const { return _iterator<const T>(m_node); }
+
+    private:
+        friend class indexed_list;
+
+        _node_base* m_node = nullptr;
+    };
+
+    using iterator = _iterator<value_type>;
+    using const_iterator = _iterator<const value_type>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Element access, positional access is O(log n)
+    reference at( size_type pos );
+    const_reference at( size_type pos ) const;
+
+    reference operator[]( size_type pos ) { return as_node(node_at(pos))->value; }
+    const_reference operator[]( size_type pos ) const { return as_node(node_at(pos))->value; }
+
+    reference front() noexcept { return as_node(m_leftmost)->value; }
+    const_reference front() const noexcept { return as_node(m_leftmost)->value; }
+
+    reference back() noexcept { return *std::prev(end()); }
+    const_reference back() const noexcept { return *std::prev(end()); }
+
+    // Iterators
+
+    iterator begin() noexcept { return iterator(m_leftmost); }
+    const_iterator begin() const noexcept { return const_iterator(m_leftmost); }
+    const_iterator cbegin() const noexcept { return const_iterator(m_leftmost); }
+
+    iterator end() noexcept { return iterator(header()); }
+    const_iterator end() const noexcept { return const_iterator(header()); }
+    const_iterator cend() const noexcept { return const_iterator(header()); }
+
+    reverse_iterator rbegin() noexcept { return std::make_reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return std::make_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return std::make_reverse_iterator(cend()); }
+
+    reverse_iterator rend() noexcept { return std::make_reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return std::make_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return std::make_reverse_iterator(cbegin()); }
+
+    // Conversion between positions and iterators in O(log n)
+    iterator nth( size_type index ) noexcept { return iterator(node_at(index)); }
+    const_iterator nth( size_type index ) const noexcept { return const_iterator(node_at(index)); }
+    size_type index_of( const_iterator it ) const noexcept;
+
+    // Capacity methods
+    bool empty() const noexcept { return size() == 0; }
+    size_type size() const noexcept { return subtree_size(root()); }
+    size_type max_size() const noexcept { return std::allocator_traits<node_allocator_type>::max_size(m_allocator); }
+
+    // Modifiers
+    void clear() noexcept;
+    void swap( indexed_list& other );
+
+    void push_back( const value_type& item ) { emplace(end(), item); }
+    void push_back( value_type&& item ) { emplace(end(), std::move(item)); }
+    void push_front( const value_type& item ) { emplace(begin(), item); }
+    void push_front( value_type&& item ) { emplace(begin(), std::move(item)); }
+
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(std::prev(end())); }
+
+    void resize( size_type count ) { resize(count, value_type()); }
+    void resize( size_type count, const value_type& value );
+
+    // Insert
+    iterator insert( const_iterator pos, const T& value ) { return emplace(pos, value); }
+    iterator insert( const_iterator pos, T&& value ) { return emplace(pos, std::move(value)); }
+    iterator insert( const_iterator pos, size_type count, const T& value );
+    template<class InputIt, std::enable_if_t<std::is_same_v<T, typename std::remove_const<typename std::iterator_traits<InputIt>::value_type>::type>, int> = 0>
+    iterator insert( const_iterator pos, InputIt first, InputIt last );
+    iterator insert( const_iterator pos, std::initializer_list<T> ilist ) { return insert(pos, ilist.begin(), ilist.end()); }
+    iterator insert( size_type index, const T& value ) { return emplace(nth(index), value); }
+    iterator insert( size_type index, T&& value ) { return emplace(nth(index), std::move(value)); }
+
+    // Erase
+    iterator erase( const_iterator pos );
+    iterator erase( const_iterator first, const_iterator last );
+    iterator erase( size_type index ) { return erase(nth(index)); }
+
+    // Emplace
+    template<typename... Args>
+    reference emplace_back( Args&&... args ) { return *emplace(end(), std::forward<Args>(args)...); }
+    template<typename... Args>
+    reference emplace_front( Args&&... args ) { return *emplace(begin(), std::forward<Args>(args)...); }
+    template< class... Args >
+    iterator emplace( const_iterator pos, Args&&... args ) { return insert_node(pos.m_node, construct(std::forward<Args>(args)...)); }
+
+    // Remove
+    size_type remove( const T& value ) { return remove_impl([&value](const T& v) { return v == value; }); }
+    template<typename UnaryPredicate>
+    size_type remove( UnaryPredicate comp ) { return remove_impl(comp); }
+
+    // Reverse
+    void reverse() noexcept;
+
+    allocator_type get_allocator() const { return allocator_type(m_allocator); }
+
+private:
+
+    // Header node is the end() position, the root of the tree
+    // is its left child, so the header follows all items in order.
+    struct _node_base
+    {
+        _node_base* parent = nullptr;
+        _node_base* left = nullptr;
+        _node_base* right = nullptr;
+        size_type size = 0;
+        std::uint32_t priority = 0;
+    };
+
+    struct _node : public _node_base
+    {
+        template<typename... Args>
+        _node( Args&&... args ) : value(std::forward<Args>(args)...) { }
+
+        T value;
+    };
+
+    static _node* as_node( _node_base* node ) noexcept { return static_cast<_node*>(node); }
+    static size_type subtree_size( const _node_base* node ) noexcept { return node ? node->size : 0; }
+    static _node_base* next_node( _node_base* node ) noexcept;
+    static _node_base* prev_node( _node_base* node ) noexcept;
+    static void update_size( _node_base* node ) noexcept { node->size = 1 + subtree_size(node->left) + subtree_size(node->right); }
+
+    _node_base* header() const noexcept { return const_cast<_node_base*>(&m_header); }
+    _node_base* root() const noexcept { return m_header.left; }
+    _node_base* node_at( size_type index ) const noexcept;
+
+    template<typename... Args>
+    _node* construct( Args&&... args );
+    void destroy( _node* node ) noexcept;
+    void destroy_subtree( _node_base* node ) noexcept;
+    void swap_nodes( indexed_list& other ) noexcept;
+    void reset_header() noexcept;
+
+    iterator insert_node( _node_base* pos, _node* node ) noexcept;
+    void rotate_up( _node_base* node ) noexcept;
+    std::uint32_t next_priority() noexcept;
+
+    template<typename UnaryPredicate>
+    size_type remove_impl( UnaryPredicate comp );
+
+    node_allocator_type m_allocator;
+    _node_base m_header;
+    _node_base* m_leftmost = &m_header;
+    std::uint32_t m_random = 0x9E3779B9u;
+};
+
+template<typename T, typename Allocator>
+indexed_list<T, Allocator>& indexed_list<T, Allocator>::operator=( const indexed_list& other )
+{
+    if (this == &other)
+        return *this;
+
+    // All nodes are released before the allocator is propagated,
+    // they must be released by the allocator which allocated them.
+    clear();
+
+    if constexpr (std::allocator_traits<node_allocator_type>::propagate_on_container_copy_assignment::value)
+    {
+        m_allocator = other.m_allocator;
+    }
+
+    insert(end(), other.begin(), other.end());
+    return *this;
+}
+
+template<typename T, typename Allocator>
+indexed_list<T, Allocator>& indexed_list<T, Allocator>::operator=( indexed_list&& other )
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    if constexpr (std::allocator_traits<node_allocator_type>::propagate_on_container_move_assignment::value)
+    {
+        m_allocator = other.m_allocator;
+        swap_nodes(other);
+    }
+    else if (m_allocator == other.m_allocator)
+    {
+        swap_nodes(other);
+    }
+    else
+    {
+        // We can't release the nodes of the other list, so move the items
+        insert(end(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    }
+
+    return *this;
+}
+
+template<typename T, typename Allocator>
+typename indexed_list<T, Allocator>::reference indexed_list<T, Allocator>::at( size_type pos )
+{
+    if (pos >= size())
+    {
+        throw std::out_of_range("Index out of range.");
+    }
+
+    return (*this)[pos];
+}
+
+template<typename T, typename Allocator>
+typename indexed_list<T, Allocator>::const_reference indexed_list<T, Allocator>::at( size_type pos ) const
+{
+    if (pos >= size())
+    {
+        throw std::out_of_range("Index out of range.");
+    }
+
+    return (*this)[pos];
+}
+
+template<typename T, typename Allocator>
+typename indexed_list<T, Allocator>::size_type indexed_list<T, Allocator>::index_of( const_iterator it ) const noexcept
+{
+    _node_base* node = it.m_node;
+
+    if (node == header())
+        return size();
+
+    // Count the items preceding the node on the path to the root
+    size_type index = subtree_size(node->left);
+    while (node->parent != header())
+    {
+        if (node == node->parent->right)
+        {
+            index += subtree_size(node->parent->left) + 1;
+        }
+
+        node = node->parent;
+    }
+
+    return index;
+}
+
+template<typename T, typename Allocator>
+void indexed_list<T, Allocator>::clear() noexcept
+{
+    destroy_subtree(root());
+    m_header.left = nullptr;
+    m_leftmost = &m_header;
+}
+
+template<typename T, typename Allocator>
+void indexed_list<T, Allocator>::swap( indexed_list& other )
+{
+    swap_nodes(other);
+
+    if constexpr (std::allocator_traits<node_allocator_type>::propagate_on_container_swap::value)
+    {
+        std::swap(m_allocator, other.m_allocator);
+    }
+}
+
+template<typename T, typename Allocator>
+void indexed_list<T, Allocator>::resize( size_type count, const value_type& value )
+{
+    if (count < size())
+    {
+        erase(nth(count), end());
+    }
+    else if (count > size())
+    {
+        insert(end(), count - size(), value);
+    }
+}
+
+template<typename T, typename Allocator>
+typename indexed_list<T, Allocator>::iterator indexed_list<T, Allocator>::insert( const_iterator pos, size_type count, const T& value )
+{
+    for (size_type i = 0; i < count; ++i)
+    {
+        pos = insert(pos, value);
+    }
+
+    return iterator(pos.m_node);
+}
+
+template<typename T, typename Allocator>
+template<class InputIt, std::enable_if_t<std::is_same_v<T, typename std::remove_const<typename std::iterator_traits<InputIt>::value_type>::type>, int>>
+typename indexed_list<T, Allocator>::iterator indexed_list<T, Allocator>::insert( const_iterator pos, InputIt first, InputIt last )
+{
+    // Items are inserted before pos in their order, pos stays valid
+    iterator result(pos.m_node);
+    bool isFirst = true;
+
+    for (; first != last; ++first)
+    {
+        iterator it = emplace(pos, *first);
+
+        if (isFirst)
+        {
+            result = it;
+            isFirst = false;
+        }
+    }
+
+    return result;
+}
+
+template<typename T, typename Allocator>
+typename indexed_list<T, Allocator>::iterator indexed_list<T, Allocator>::erase( const_iterator pos )
+{
+    _node_base* node = pos.m_node;
+    _node_base* next = next_node(node);
+
+    if (node == m_leftmost)
+    {
+        m_leftmost = next;
+    }
+
+    // Rotate the node down until it becomes a leaf, the child
+    // with higher priority is rotated up, so the heap order is kept.
+    while (node->left || node->right)
+    {
+        _node_base* child = node->right;
+        if (node->left && (!node->right || node->left->priority > node->right->priority))
+        {
+            child = node->left;
+        }
+
+        rotate_up(child);
+    }
+
+    _node_base* parent = node->parent;
+    if (parent == header() || parent->left == node)
+    {
+        parent->left = nullptr;
+    }
+    else
+    {
+        parent->right = nullptr;
+    }
+
+    for (; parent != header(); parent = parent->parent)
+    {
+        --parent->size;
+    }
+
+    destroy(as_node(node));
+    return iterator(next);
+}
+
+template<typename T, typename Allocator>
+typename indexed_list<T, Allocator>::iterator indexed_list<T, Allocator>::erase( const_iterator first, const_iterator last )
+{
+    while (first != last)
+    {
+        first = erase(first);
+    }
+
+    return iterator(last.m_node);
+}
+
+template<typename T, typename Allocator>
+void indexed_list<T, Allocator>::reverse() noexcept
+{
+    if (empty())
+        return;
+
+    // Mirrored tree has the reversed order of items
+    _node_base* node = root();
+    _node_base* leftmost = node;
+
+    while (leftmost->right)
+    {
+        leftmost = leftmost->right;
+    }
+
+    // Iterative traversal using the parent pointers
+    _node_base* previous = header();
+    while (node != header())
+    {
+        _node_base* next = nullptr;
+
+        if (previous == node->parent)
+        {
+            std::swap(node->left, node->right);
+            next = node->left ? node->left : (node->right ? node->right : node->parent);
+        }
+        else if (previous == node->left)
+        {
+            next = node->right ? node->right : node->parent;
+        }
+        else
+        {
+            next = node->parent;
+        }
+
+        previous = node;
+        node = next;
+    }
+
+    m_leftmost = leftmost;
+}
+
+template<typename T, typename Allocator>
+typename indexed_list<T, Allocator>::_node_base* indexed_list<T, Allocator>::next_node( _node_base* node ) noexcept
+{
+    if (node->right)
+    {
+        node = node->right;
+        while (node->left)
+        {
+            node = node->left;
+        }
+
+        return node;
+    }
+
+    // Header has the root as its left child, so the last item
+    // reaches the header, which is the end() position.
+    _node_base* parent = node->parent;
+    while (node == parent->right)
+    {
+        node = parent;
+        parent = parent->parent;
+    }
+
+    return parent;
+}
+
+template<typename T, typename Allocator>
+typename indexed_list<T, Allocator>::_node_base* indexed_list<T, Allocator>::prev_node( _node_base* node ) noexcept
+{
+    if (node->left)
+    {
+        node = node->left;
+        while (node->right)
+        {
+            node = node->right;
+        }
+
+        return node;
+    }
+
+    _node_base* parent = node->parent;
+    while (node == parent->left)
+    {
+        node = parent;
+        parent = parent->parent;
+    }
+
+    return parent;
+}
+
+template<typename T, typename Allocator>
+typename indexed_list<T, Allocator>::_node_base* indexed_list<T, Allocator>::node_at( size_type index ) const noexcept
+{
+    _node_base* node = root();
+
+    while (node)
+    {
+        const size_type leftSize = subtree_size(node->left);
+
+        if (index < leftSize)
+        {
+            node = node->left;
+        }
+        else if (index == leftSize)
+        {
+            return node;
+        }
+        else
+        {
+            index -= leftSize + 1;
+            node = node->right;
+        }
+    }
+
+    // Index equal to the size is the end() position
+    return header();
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+typename indexed_list<T, Allocator>::_node* indexed_list<T, Allocator>::construct( Args&&... args )
+{
+    _node* node = std::allocator_traits<node_allocator_type>::allocate(m_allocator, 1);
+
+    try
+    {
+        std::allocator_traits<node_allocator_type>::construct(m_allocator, node, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        std::allocator_traits<node_allocator_type>::deallocate(m_allocator, node, 1);
+        throw;
+    }
+
+    return node;
+}
+
+template<typename T, typename Allocator>
+void indexed_list<T, Allocator>::destroy( _node* node ) noexcept
+{
+    std::allocator_traits<node_allocator_type>::destroy(m_allocator, node);
+    std::allocator_traits<node_allocator_type>::deallocate(m_allocator, node, 1);
+}
+
+template<typename T, typename Allocator>
+void indexed_list<T, Allocator>::destroy_subtree( _node_base* node ) noexcept
+{
+    // Iterative post-order traversal, recursion depth is not limited
+    while (node)
+    {
+        if (node->left)
+        {
+            node = node->left;
+        }
+        else if (node->right)
+        {
+            node = node->right;
+        }
+        else
+        {
+            _node_base* parent = node->parent;
+
+            if (parent != header())
+            {
+                (parent->left == node ? parent->left : parent->right) = nullptr;
+            }
+            else
+            {
+                parent = nullptr;
+            }
+
+            destroy(as_node(node));
+            node = parent;
+        }
+    }
+}
+
+template<typename T, typename Allocator>
+void indexed_list<T, Allocator>::swap_nodes( indexed_list& other ) noexcept
+{
+    std::swap(m_header.left, other.m_header.left);
+    std::swap(m_leftmost, other.m_leftmost);
+    std::swap(m_random, other.m_random);
+
+    // Roots and leftmost nodes still refer to the old headers
+    reset_header();
+    other.reset_header();
+}
+
+template<typename T, typename Allocator>
+void indexed_list<T, Allocator>::reset_header() noexcept
+{
+    if (root())
+    {
+        root()->parent = &m_header;
+    }
+    else
+    {
+        m_leftmost = &m_header;
+    }
+}
+
+template<typename T, typename Allocator>
+typename indexed_list<T, Allocator>::iterator indexed_list<T, Allocator>::insert_node( _node_base* pos, _node* node ) noexcept
+{
+    node->left = nullptr;
+    node->right = nullptr;
+    node->size = 1;
+    node->priority = next_priority();
+
+    // Node is attached as a leaf just before pos in the order
+    if (!root())
+    {
+        node->parent = header();
+        m_header.left = node;
+    }
+    else if (pos == header())
+    {
+        _node_base* last = root();
+        while (last->right)
+        {
+            last = last->right;
+        }
+
+        node->parent = last;
+        last->right = node;
+    }
+    else if (!pos->left)
+    {
+        node->parent = pos;
+        pos->left = node;
+    }
+    else
+    {
+        _node_base* prev = prev_node(pos);
+        node->parent = prev;
+        prev->right = node;
+    }
+
+    if (pos == m_leftmost)
+    {
+        m_leftmost = node;
+    }
+
+    for (_node_base* parent = node->parent; parent != header(); parent = parent->parent)
+    {
+        ++parent->size;
+    }
+
+    // Restore the heap order of priorities
+    while (node->parent != header() && node->priority > node->parent->priority)
+    {
+        rotate_up(node);
+    }
+
+    return iterator(node);
+}
+
+template<typename T, typename Allocator>
+void indexed_list<T, Allocator>::rotate_up( _node_base* node ) noexcept
+{
+    // Node takes the place of its parent, the order of items is kept
+    _node_base* parent = node->parent;
+    _node_base* grandParent = parent->parent;
+
+    if (node == parent->left)
+    {
+        parent->left = node->right;
+        if (node->right)
+        {
+            node->right->parent = parent;
+        }
+
+        node->right = parent;
+    }
+    else
+    {
+        parent->right = node->left;
+        if (node->left)
+        {
+            node->left->parent = parent;
+        }
+
+        node->left = parent;
+    }
+
+    parent->parent = node;
+    node->parent = grandParent;
+
+    if (grandParent == header() || grandParent->left == parent)
+    {
+        grandParent->left = node;
+    }
+    else
+    {
+        grandParent->right = node;
+    }
+
+    update_size(parent);
+    update_size(node);
+}
+
+template<typename T, typename Allocator>
+std::uint32_t indexed_list<T, Allocator>::next_priority() noexcept
+{
+    // Xorshift generator, it is fast and good enough for balancing
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 17;
+    m_random ^= m_random << 5;
+    return m_random;
+}
+
+template<typename T, typename Allocator>
+template<typename UnaryPredicate>
+typename indexed_list<T, Allocator>::size_type indexed_list<T, Allocator>::remove_impl( UnaryPredicate comp )
+{
+    size_type removedItems = 0;
+
+    for (auto it = begin(); it != end();)
+    {
+        if (comp(*it))
+        {
+            it = erase(it);
+            ++removedItems;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return removedItems;
+}
+
+} // namespace course_l01
+
+#endif // CUSTOM_INDEXED_LIST_H
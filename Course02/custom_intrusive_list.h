@@ -0,0 +1,551 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#ifndef CUSTOM_INTRUSIVE_LIST_H
+#define CUSTOM_INTRUSIVE_LIST_H
+
+#include <iterator>
+#include <functional>
+#include <utility>
+#include <memory>
+
+#include "custom_node_sort.h"
+
+namespace course_l01
+{
+
+// Hook, which must be a member of the objects stored in the intrusive list.
+// Copy of the hook is never linked, so objects with hooks can be copied.
+// Hook remembers the object which owns it, while it is linked.
+class intrusive_list_hook
+{
+public:
+    intrusive_list_hook() = default;
+    intrusive_list_hook( const intrusive_list_hook& ) noexcept { }
+    intrusive_list_hook& operator=( const intrusive_list_hook& ) noexcept { return *this; }
+
+    // Returns true, if the object is linked in some list
+    bool is_linked() const noexcept { return next != nullptr; }
+
+private:
+    template<typename T, intrusive_list_hook T::*Hook>
+    friend class intrusive_list;
+    template<typename Node>
+    friend class node_chain_sorter;
+
+    // Used for the sentinel of the list
+    intrusive_list_hook( intrusive_list_hook* prevHook, intrusive_list_hook* nextHook ) noexcept : prev(prevHook), next(nextHook) { }
+
+    intrusive_list_hook* prev = nullptr;
+    intrusive_list_hook* next = nullptr;
+    void* owner = nullptr;
+};
+
+// Doubly linked list of objects, which are not owned by the list.
+// Pointers to the neighbours are stored in the hook inside the object,
+// so insert and erase never allocate memory, and objects can be moved
+// between lists in O(1). Object must not be destroyed while it is linked.
+// Each hook links the object into at most one list, object with several
+// hooks can be linked in several lists at once.
+template<typename T, intrusive_list_hook T::*Hook>
+class intrusive_list
+{
+public:
+    // Type declarations
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    intrusive_list() = default;
+    template< class InputIt >
+    intrusive_list( InputIt first, InputIt last ) { insert(end(), first, last); }
+    intrusive_list( const intrusive_list& ) = delete;
+    intrusive_list( intrusive_list&& other ) noexcept { swap(other); }
+    ~intrusive_list() { clear(); }
+
+    // Assignment operator
+    intrusive_list& operator=( const intrusive_list& ) = delete;
+    intrusive_list& operator=( intrusive_list&& other ) noexcept;
+
+    template<typename Value>
+    class _iterator
+    {
+    public:
+        using value_type = Value;
+        using reference = Value&;
+        using pointer = Value*;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        explicit _iterator(intrusive_list_hook* node) : m_node(node) {}
+
+        reference operator*() const { return *owner_of(m_node); }
+        pointer operator->() const { return owner_of(m_node); }
+        _iterator& operator++() { m_node = m_node->next; return *this; }
+        _iterator operator++(int) { _iterator temp = *this; ++(*this); return temp; }
+        _iterator& operator--() { m_node = m_node->prev; return *this; }
+        _iterator operator--(int) { _iterator temp = *this; --(*this); return temp; }
+
+        bool operator==(const _iterator& other) const { return m_node == other.m_node; }
+        bool operator!=(const _iterator& other) const { return !(*this == other); }
+
+        operator _iterator<const T>() const { return _iterator<const T>(m_node); }
+
+    private:
+        friend class intrusive_list;
+
+        intrusive_list_hook* m_node = nullptr;
+    };
+
+    using iterator = _iterator<value_type>;
+    using const_iterator = _iterator<const value_type>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Element access
+
+    reference front() noexcept { return *owner_of(m_sentinel.next); }
+    const_reference front() const noexcept { return *owner_of(m_sentinel.next); }
+
+    reference back() noexcept { return *owner_of(m_sentinel.prev); }
+    const_reference back() const noexcept { return *owner_of(m_sentinel.prev); }
+
+    // Iterators
+
+    iterator begin() noexcept { return iterator(m_sentinel.next); }
+    const_iterator begin() const noexcept { return const_iterator(m_sentinel.next); }
+    const_iterator cbegin() const noexcept { return const_iterator(m_sentinel.next); }
+
+    iterator end() noexcept { return iterator(sentinel()); }
+    const_iterator end() const noexcept { return const_iterator(sentinel()); }
+    const_iterator cend() const noexcept { return const_iterator(sentinel()); }
+
+    reverse_iterator rbegin() noexcept { return std::make_reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return std::make_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return std::make_reverse_iterator(cend()); }
+
+    reverse_iterator rend() noexcept { return std::make_reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return std::make_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return std::make_reverse_iterator(cbegin()); }
+
+    // Returns iterator to the object, which is linked in this list
+    iterator iterator_to( reference value ) noexcept { return iterator(&(value.*Hook)); }
+    const_iterator iterator_to( const_reference value ) const noexcept { return const_iterator(const_cast<intrusive_list_hook*>(&(value.*Hook))); }
+
+    // Capacity methods
+    bool empty() const noexcept { return m_size == 0; }
+    size_type size() const noexcept { return m_size; }
+
+    // Modifiers, objects are only unlinked, never destroyed
+    void clear() noexcept;
+    void swap( intrusive_list& other ) noexcept;
+
+    void push_back( reference value ) noexcept { insert(end(), value); }
+    void push_front( reference value ) noexcept { insert(begin(), value); }
+
+    void pop_front() noexcept { erase(begin()); }
+    void pop_back() noexcept { erase(std::prev(end())); }
+
+    // Insert
+    iterator insert( const_iterator pos, reference value ) noexcept;
+    template<class InputIt>
+    iterator insert( const_iterator pos, InputIt first, InputIt last ) noexcept;
+
+    // Erase
+    iterator erase( const_iterator pos ) noexcept;
+    iterator erase( const_iterator first, const_iterator last ) noexcept;
+
+    // Splice
+    void splice( const_iterator pos, intrusive_list& other ) noexcept { splice_impl(pos, other); }
+    void splice( const_iterator pos, intrusive_list&& other ) noexcept { splice_impl(pos, other); }
+    void splice( const_iterator pos, intrusive_list& other, const_iterator it ) noexcept { splice_impl(pos, other, it); }
+    void splice( const_iterator pos, intrusive_list&& other, const_iterator it ) noexcept { splice_impl(pos, other, it); }
+    void splice( const_iterator pos, intrusive_list& other, const_iterator it1, const_iterator it2 ) noexcept { splice_impl(pos, other, it1, it2); }
+    void splice( const_iterator pos, intrusive_list&& other, const_iterator it1, const_iterator it2 ) noexcept { splice_impl(pos, other, it1, it2); }
+
+    // Merge
+    void merge( intrusive_list& other ) { merge(other, std::less<T>()); }
+    void merge( intrusive_list&& other ) { merge(other, std::less<T>()); }
+    template<typename Comparator>
+    void merge( intrusive_list& other, Comparator comp ) { merge_impl(other, comp); }
+    template<typename Comparator>
+    void merge( intrusive_list&& other, Comparator comp ) { merge_impl(other, comp); }
+
+    // Sort
+    void sort() { sort(std::less<T>()); }
+    template<typename Comparator>
+    void sort( Comparator comp );
+
+    // Remove
+    size_type remove( const T& value ) { return remove_impl([&value](const T& v) { return v == value; }); }
+    template<typename UnaryPredicate>
+    size_type remove( UnaryPredicate comp ) { return remove_impl(comp); }
+
+    // Reverse
+    void reverse() noexcept;
+
+    // Unique
+    size_type unique() { return unique([](const auto& l, const auto& r) { return l == r; }); }
+    template< class BinaryPredicate >
+    size_type unique( BinaryPredicate p );
+
+private:
+    static T* owner_of( intrusive_list_hook* node ) noexcept { return static_cast<T*>(node->owner); }
+    intrusive_list_hook* sentinel() const noexcept { return const_cast<intrusive_list_hook*>(&m_sentinel); }
+
+    void reset_sentinel() noexcept;
+
+    // Restores the list from the null terminated chain after sorting
+    void relink_nodes( intrusive_list_hook* chain ) noexcept;
+    void unlink_nodes( intrusive_list_hook* first, intrusive_list_hook* last, size_type count ) noexcept;
+    void link_nodes( intrusive_list_hook* pos, intrusive_list_hook* first, intrusive_list_hook* last, size_type count ) noexcept;
+
+    void splice_impl( const_iterator pos, intrusive_list& other ) noexcept;
+    void splice_impl( const_iterator pos, intrusive_list& other, const_iterator it ) noexcept;
+    void splice_impl( const_iterator pos, intrusive_list& other, const_iterator it1, const_iterator it2 ) noexcept;
+
+    template<typename Comparator>
+    void merge_impl( intrusive_list& other, Comparator comp );
+
+    template<typename UnaryPredicate>
+    size_type remove_impl( UnaryPredicate comp );
+
+    intrusive_list_hook m_sentinel{ &m_sentinel, &m_sentinel };
+    size_type m_size = 0;
+};
+
+template<typename T, intrusive_list_hook T::*Hook>
+intrusive_list<T, Hook>& intrusive_list<T, Hook>::operator=( intrusive_list&& other ) noexcept
+{
+    if (this != &other)
+    {
+        clear();
+        swap(other);
+    }
+
+    return *this;
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::clear() noexcept
+{
+    intrusive_list_hook* node = m_sentinel.next;
+    while (node != &m_sentinel)
+    {
+        intrusive_list_hook* next = node->next;
+        node->prev = nullptr;
+        node->next = nullptr;
+        node = next;
+    }
+
+    m_size = 0;
+    reset_sentinel();
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::swap( intrusive_list& other ) noexcept
+{
+    std::swap(m_sentinel.prev, other.m_sentinel.prev);
+    std::swap(m_sentinel.next, other.m_sentinel.next);
+    std::swap(m_size, other.m_size);
+
+    // Neighbours of the sentinels still point to the old sentinels
+    reset_sentinel();
+    other.reset_sentinel();
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::reset_sentinel() noexcept
+{
+    if (m_size == 0)
+    {
+        m_sentinel.prev = &m_sentinel;
+        m_sentinel.next = &m_sentinel;
+    }
+    else
+    {
+        m_sentinel.prev->next = &m_sentinel;
+        m_sentinel.next->prev = &m_sentinel;
+    }
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::relink_nodes( intrusive_list_hook* chain ) noexcept
+{
+    // Restore previous pointers and close the circle
+    // by the sentinel, size remains the same.
+    intrusive_list_hook* prev = &m_sentinel;
+    for (intrusive_list_hook* node = chain; node; node = node->next)
+    {
+        node->prev = prev;
+        prev->next = node;
+        prev = node;
+    }
+
+    prev->next = &m_sentinel;
+    m_sentinel.prev = prev;
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::insert( const_iterator pos, reference value ) noexcept
+{
+    intrusive_list_hook* node = &(value.*Hook);
+    node->owner = std::addressof(value);
+    link_nodes(pos.m_node, node, node, 1);
+    return iterator(node);
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+template<class InputIt>
+typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::insert( const_iterator pos, InputIt first, InputIt last ) noexcept
+{
+    iterator result(pos.m_node);
+    bool isFirst = true;
+
+    for (; first != last; ++first)
+    {
+        iterator it = insert(pos, *first);
+
+        if (isFirst)
+        {
+            result = it;
+            isFirst = false;
+        }
+    }
+
+    return result;
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::erase( const_iterator pos ) noexcept
+{
+    intrusive_list_hook* node = pos.m_node;
+    intrusive_list_hook* next = node->next;
+
+    unlink_nodes(node, node, 1);
+    node->prev = nullptr;
+    node->next = nullptr;
+
+    return iterator(next);
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::erase( const_iterator first, const_iterator last ) noexcept
+{
+    while (first != last)
+    {
+        first = erase(first);
+    }
+
+    return iterator(last.m_node);
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::unlink_nodes( intrusive_list_hook* first, intrusive_list_hook* last, size_type count ) noexcept
+{
+    // Connect the neighbours of the range [first, last] together
+    first->prev->next = last->next;
+    last->next->prev = first->prev;
+    m_size -= count;
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::link_nodes( intrusive_list_hook* pos, intrusive_list_hook* first, intrusive_list_hook* last, size_type count ) noexcept
+{
+    // Insert the chain [first, last] before the node pos
+    intrusive_list_hook* prev = pos->prev;
+
+    first->prev = prev;
+    last->next = pos;
+    prev->next = first;
+    pos->prev = last;
+
+    m_size += count;
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::splice_impl( const_iterator pos, intrusive_list& other ) noexcept
+{
+    if (this == &other || other.empty())
+        return;
+
+    intrusive_list_hook* first = other.m_sentinel.next;
+    intrusive_list_hook* last = other.m_sentinel.prev;
+    const size_type count = other.m_size;
+
+    other.unlink_nodes(first, last, count);
+    link_nodes(pos.m_node, first, last, count);
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::splice_impl( const_iterator pos, intrusive_list& other, const_iterator it ) noexcept
+{
+    if (it == other.end() || pos == it)
+        return;
+
+    intrusive_list_hook* node = it.m_node;
+    other.unlink_nodes(node, node, 1);
+    link_nodes(pos.m_node, node, node, 1);
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::splice_impl( const_iterator pos, intrusive_list& other, const_iterator it1, const_iterator it2 ) noexcept
+{
+    if (it1 == it2)
+        return;
+
+    intrusive_list_hook* first = it1.m_node;
+    intrusive_list_hook* last = it2.m_node->prev;
+
+    // Range must be counted only, if objects are moved between
+    // different lists. Splice within the same list keeps the size.
+    const size_type count = (this != &other) ? static_cast<size_type>(std::distance(it1, it2)) : 0;
+
+    other.unlink_nodes(first, last, count);
+    link_nodes(pos.m_node, first, last, count);
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+template<typename Comparator>
+void intrusive_list<T, Hook>::merge_impl( intrusive_list& other, Comparator comp )
+{
+    if (this == &other)
+        return;
+
+    intrusive_list_hook* node = m_sentinel.next;
+    while (node != &m_sentinel && !other.empty())
+    {
+        if (comp(other.front(), *owner_of(node)))
+        {
+            // Find the whole run of objects from the other list, which
+            // belongs before the current node, and relink it at once.
+            intrusive_list_hook* first = other.m_sentinel.next;
+            intrusive_list_hook* last = first;
+            size_type count = 1;
+
+            while (last->next != &other.m_sentinel && comp(*owner_of(last->next), *owner_of(node)))
+            {
+                last = last->next;
+                ++count;
+            }
+
+            other.unlink_nodes(first, last, count);
+            link_nodes(node, first, last, count);
+        }
+
+        node = node->next;
+    }
+
+    splice_impl(end(), other);
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+template<typename Comparator>
+void intrusive_list<T, Hook>::sort( Comparator comp )
+{
+    if (size() < 2)
+        return;
+
+    // Chain is terminated by null instead of the sentinel during the sort
+    intrusive_list_hook* chain = m_sentinel.next;
+    m_sentinel.prev->next = nullptr;
+
+    auto compareNodes = [&comp](intrusive_list_hook* left, intrusive_list_hook* right) { return comp(*owner_of(left), *owner_of(right)); };
+
+    try
+    {
+        node_chain_sorter<intrusive_list_hook>::sort(chain, compareNodes);
+    }
+    catch (...)
+    {
+        // Comparator has thrown, the chain contains all nodes again
+        relink_nodes(chain);
+        throw;
+    }
+
+    relink_nodes(chain);
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+template<typename UnaryPredicate>
+typename intrusive_list<T, Hook>::size_type intrusive_list<T, Hook>::remove_impl( UnaryPredicate comp )
+{
+    size_type removedItems = 0;
+
+    for (auto it = begin(); it != end();)
+    {
+        if (comp(*it))
+        {
+            it = erase(it);
+            ++removedItems;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return removedItems;
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+void intrusive_list<T, Hook>::reverse() noexcept
+{
+    // Sentinel is reversed too, so head and tail are swapped
+    intrusive_list_hook* node = &m_sentinel;
+    do
+    {
+        std::swap(node->prev, node->next);
+        node = node->prev;
+    }
+    while (node != &m_sentinel);
+}
+
+template<typename T, intrusive_list_hook T::*Hook>
+template<class BinaryPredicate>
+typename intrusive_list<T, Hook>::size_type intrusive_list<T, Hook>::unique( BinaryPredicate p )
+{
+    if (empty())
+        return 0;
+
+    size_type removedItems = 0;
+
+    for (auto it = std::next(begin()); it != end();)
+    {
+        if (p(*std::prev(it), *it))
+        {
+            it = erase(it);
+            ++removedItems;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return removedItems;
+}
+
+} // namespace course_l01
+
+#endif // CUSTOM_INTRUSIVE_LIST_H
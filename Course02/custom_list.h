@@ -21,19 +21,32 @@
 #define CUSTOM_LIST_H
 
 #include <iterator>
+#include <memory>
+#include <functional>
+#include <utility>
+#include <thread>
+#include <exception>
+#include <algorithm>
+
+#include "custom_vector.h"
+#include "custom_pool_allocator.h"
+#include "custom_node_sort.h"
 
 namespace course_l01
 {
 
-template<typename T>
+template<typename T, typename Allocator = std::allocator<T>>
 class list
 {
 private:
+    struct _node_base;
     struct _node;
+    using node_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<_node>;
 
 public:
     // Type declarations
     using value_type = T;
+    using allocator_type = Allocator;
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
     using reference = value_type&;
@@ -42,17 +55,18 @@ public:
     using const_pointer = const value_type*;
 
     list() = default;
-    explicit list( size_type count ) { resize(count); }
+    explicit list( const Allocator& alloc ) : m_allocator(alloc) { }
+    explicit list( size_type count, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { resize(count); }
     template< class InputIt >
-    list( InputIt first, InputIt last ) { insert(end(), first, last); }
-    list( const list& other ) { insert(end(), other.begin(), other.end()); }
-    list( list&& other ) { swap(other); }
-    list( std::initializer_list<T> init ) { insert(end(), init.begin(), init.end()); }
+    list( InputIt first, InputIt last, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { insert(end(), first, last); }
+    list( const list& other ) : m_allocator(std::allocator_traits<node_allocator_type>::select_on_container_copy_construction(other.m_allocator)) { insert(end(), other.begin(), other.end()); }
+    list( list&& other ) : m_allocator(other.m_allocator) { swap_nodes(other); }
+    list( std::initializer_list<T> init, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { insert(end(), init.begin(), init.end()); }
     ~list() { clear(); }
 
     // Assignment operator
-    list& operator=( const list& other ) { clear(); insert(end(), other.begin(), other.end()); return *this; }
-    list& operator=( list&& other ) { swap(other); return *this; }
+    list& operator=( const list& other );
+    list& operator=( list&& other );
 
     // Assign methods
     void assign( size_type count, const T& value ) { clear(); insert(end(), count, value); }
@@ -70,25 +84,24 @@ public:
         using difference_type = std::ptrdiff_t;
         using iterator_category = std::bidirectional_iterator_tag;
 
-        _iterator(const list* myList, _node* node) : m_list(myList), m_node(node) {}
+        explicit _iterator(_node_base* node) : m_node(node) {}
 
-        reference operator*() const { return m_node->value; }
-        pointer operator->() const { return &m_node->value; }
+        reference operator*() const { return as_node(m_node)->value; }
+        pointer operator->() const { return &as_node(m_node)->value; }
         _iterator& operator++() { m_node = m_node->next; return *this; }
         _iterator operator++(int) { _iterator temp = *this; ++(*this); return temp; }
-        _iterator& operator--() { m_node = m_node ? m_node->prev : m_list->m_tail; return *this; }
+        _iterator& operator--() { m_node = m_node->prev; return *this; }
         _iterator operator--(int) { _iterator temp = *this; --(*this); return temp; }
 
         bool operator==(const _iterator& other) const { return m_node == other.m_node; }
         bool operator!=(const _iterator& other) const { return !(*this == other); }
 
-        operator _iterator<const T>() const { return _iterator<const T>(m_list, m_node); }
+        operator _iterator<const T>() const { return _iterator<const T>(m_node); }
 
     private:
         friend class list;
 
-        const list* m_list = nullptr;
-        _node* m_node = nullptr;
+        _node_base* m_node = nullptr;
     };
 
     using iterator = _iterator<value_type>;
@@ -98,21 +111,21 @@ public:
 
     // Element access
 
-    reference front() noexcept { return m_head->value; }
-    const_reference front() const noexcept { return m_head->value; }
+    reference front() noexcept { return as_node(m_sentinel.next)->value; }
+    const_reference front() const noexcept { return as_node(m_sentinel.next)->value; }
 
-    reference back() noexcept { return m_tail->value; }
-    const_reference back() const noexcept { return m_tail->value; }
+    reference back() noexcept { return as_node(m_sentinel.prev)->value; }
+    const_reference back() const noexcept { return as_node(m_sentinel.prev)->value; }
 
     // Iterators
 
-    iterator begin() noexcept { return iterator(this, m_head); }
-    const_iterator begin() const noexcept { return const_iterator(this, m_head); }
-    const_iterator cbegin() const noexcept { return const_iterator(this, m_head); }
+    iterator begin() noexcept { return iterator(m_sentinel.next); }
+    const_iterator begin() const noexcept { return const_iterator(m_sentinel.next); }
+    const_iterator cbegin() const noexcept { return const_iterator(m_sentinel.next); }
 
-    iterator end() noexcept { return iterator(this, nullptr); }
-    const_iterator end() const noexcept { return const_iterator(this, nullptr); }
-    const_iterator cend() const noexcept { return const_iterator(this, nullptr); }
+    iterator end() noexcept { return iterator(sentinel()); }
+    const_iterator end() const noexcept { return const_iterator(sentinel()); }
+    const_iterator cend() const noexcept { return const_iterator(sentinel()); }
 
     reverse_iterator rbegin() noexcept { return std::make_reverse_iterator(end()); }
     const_reverse_iterator rbegin() const noexcept { return std::make_reverse_iterator(end()); }
@@ -123,9 +136,9 @@ public:
     const_reverse_iterator crend() const noexcept { return std::make_reverse_iterator(cbegin()); }
 
     // Capacity methods
-    constexpr bool empty() const noexcept { return m_head == nullptr; }
+    constexpr bool empty() const noexcept { return m_size == 0; }
     constexpr size_type size() const noexcept { return m_size; }
-    constexpr size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(_node); }
+    size_type max_size() const noexcept { return std::allocator_traits<node_allocator_type>::max_size(m_allocator); }
 
     // Modifiers
     void clear() { erase(begin(), end()); }
@@ -158,11 +171,11 @@ public:
 
     // Emplace
     template<typename... Args>
-    reference emplace_back( Args&&... args ) { return *emplace(end(), std::forward<Args...>(args...)); }
+    reference emplace_back( Args&&... args ) { return *emplace(end(), std::forward<Args>(args)...); }
     template<typename... Args>
-    reference emplace_front( Args&&... args ) { return *emplace(begin(), std::forward<Args...>(args...)); }
+    reference emplace_front( Args&&... args ) { return *emplace(begin(), std::forward<Args>(args)...); }
     template< class... Args >
-    iterator emplace( const_iterator pos, Args&&... args ) { return insert_impl(pos, new _node(std::forward<Args...>(args...))); }
+    iterator emplace( const_iterator pos, Args&&... args ) { return insert_impl(pos, construct(std::forward<Args>(args)...)); }
 
     // Splice
     void splice( const_iterator pos, list& other) { splice_impl(pos, other); }
@@ -185,6 +198,17 @@ public:
     template<typename Comparator>
     void sort( Comparator comp );
 
+    // Parallel sort, pointers to the nodes are sorted on multiple threads,
+    // then the nodes are relinked, values are never copied or moved.
+    // Comparator is copied to each thread and must be safe to call
+    // concurrently. Sort is stable and the list is left unchanged,
+    // if the comparator throws.
+    void parallel_sort() { parallel_sort(std::less<T>()); }
+    template<typename Comparator>
+    void parallel_sort( Comparator comp ) { parallel_sort(comp, std::thread::hardware_concurrency()); }
+    template<typename Comparator>
+    void parallel_sort( Comparator comp, size_type maxThreadCount );
+
     // Remove
     size_type remove( const T& value ) { return remove_impl([&value](const T& v) { return v == value; }); }
     template<typename UnaryPredicate>
@@ -198,21 +222,37 @@ public:
     template< class BinaryPredicate >
     size_type unique( BinaryPredicate p );
 
+    allocator_type get_allocator() const { return allocator_type(m_allocator); }
+
 private:
 
-    struct _node
+    // Nodes form a circular list closed by the sentinel node, which is
+    // stored in the list itself and represents the end() position.
+    // So every node has valid neighbours and no null checks are needed.
+    struct _node_base
     {
-        _node() = default;
+        _node_base* prev = nullptr;
+        _node_base* next = nullptr;
+    };
+
+    struct _node : public _node_base
+    {
+        // Value is constructed in place from the arguments,
+        // no arguments means value initialization.
         template<typename... Args>
-        _node( Args&&... args ) : value(std::forward<Args...>(args)...), prev(nullptr), next(nullptr) { }
+        _node( Args&&... args ) : value(std::forward<Args>(args)...) { }
 
         T value;
-        _node* prev = nullptr;
-        _node* next = nullptr;
     };
 
-    template<typename Value>
-    _node* construct(Value&& value) { return new _node(std::forward<Value>(value)); }
+    static _node* as_node( _node_base* node ) noexcept { return static_cast<_node*>(node); }
+    _node_base* sentinel() const noexcept { return const_cast<_node_base*>(&m_sentinel); }
+
+    template<typename... Args>
+    _node* construct( Args&&... args );
+    void destroy(_node* node);
+    void swap_nodes( list& other );
+    void reset_sentinel() noexcept;
 
     iterator insert_impl(const_iterator pos, _node* newItem);
     iterator erase_impl( const_iterator pos, size_type count );
@@ -220,29 +260,144 @@ private:
     void splice_impl(const_iterator pos, list& other, const_iterator it );
     void splice_impl(const_iterator pos, list& other, const_iterator it1, const_iterator it2 );
     _node* extract_node( const_iterator pos );
-    iterator unconst_iterator( const_iterator it ) { return iterator(this, it.m_node); }
+    void unlink_nodes( _node_base* first, _node_base* last, size_type count );
+    void link_nodes( _node_base* pos, _node_base* first, _node_base* last, size_type count );
+    iterator unconst_iterator( const_iterator it ) { return iterator(it.m_node); }
 
     template<typename Comparator>
     void merge_impl( list& other, Comparator comp );
 
+    // Restores the list from the null terminated chain after sorting
+    void relink_nodes( _node_base* chain ) noexcept;
+
+    // Helpers for parallel sorting
+    template<typename Comparator>
+    static size_type merge_split( _node_base* const* first1, size_type count1, _node_base* const* first2, size_type count2, size_type position, Comparator& comp );
+    template<typename Function>
+    static void run_parallel( size_type threadCount, Function function );
+
     template<typename UnaryPredicate>
     size_type remove_impl( UnaryPredicate comp );
 
-    _node* m_head = nullptr;
-    _node* m_tail = nullptr;
+    node_allocator_type m_allocator;
+    _node_base m_sentinel = { &m_sentinel, &m_sentinel };
     size_t m_size = 0;
 };
 
+// List, whose nodes are allocated from the node pool
 template<typename T>
-void list<T>::swap( list<T>& other )
+using pooled_list = list<T, pool_allocator<T>>;
+
+template<typename T, typename Allocator>
+list<T, Allocator>& list<T, Allocator>::operator=( const list& other )
+{
+    if (this == &other)
+        return *this;
+
+    // All nodes are released before the allocator is propagated,
+    // they must be released by the allocator which allocated them.
+    clear();
+
+    if constexpr (std::allocator_traits<node_allocator_type>::propagate_on_container_copy_assignment::value)
+    {
+        m_allocator = other.m_allocator;
+    }
+
+    insert(end(), other.begin(), other.end());
+    return *this;
+}
+
+template<typename T, typename Allocator>
+list<T, Allocator>& list<T, Allocator>::operator=( list&& other )
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    if constexpr (std::allocator_traits<node_allocator_type>::propagate_on_container_move_assignment::value)
+    {
+        m_allocator = other.m_allocator;
+        swap_nodes(other);
+    }
+    else if (m_allocator == other.m_allocator)
+    {
+        swap_nodes(other);
+    }
+    else
+    {
+        // We can't release the nodes of the other list, so move the items
+        insert(end(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    }
+
+    return *this;
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+typename list<T, Allocator>::_node* list<T, Allocator>::construct( Args&&... args )
+{
+    _node* node = std::allocator_traits<node_allocator_type>::allocate(m_allocator, 1);
+
+    try
+    {
+        std::allocator_traits<node_allocator_type>::construct(m_allocator, node, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        std::allocator_traits<node_allocator_type>::deallocate(m_allocator, node, 1);
+        throw;
+    }
+
+    return node;
+}
+
+template<typename T, typename Allocator>
+void list<T, Allocator>::destroy( _node* node )
+{
+    std::allocator_traits<node_allocator_type>::destroy(m_allocator, node);
+    std::allocator_traits<node_allocator_type>::deallocate(m_allocator, node, 1);
+}
+
+template<typename T, typename Allocator>
+void list<T, Allocator>::swap_nodes( list& other )
 {
-    std::swap(m_head, other.m_head);
-    std::swap(m_tail, other.m_tail);
+    std::swap(m_sentinel, other.m_sentinel);
     std::swap(m_size, other.m_size);
+
+    // Neighbours of the sentinels still point to the old sentinels
+    reset_sentinel();
+    other.reset_sentinel();
 }
 
-template<typename T>
-void list<T>::resize( size_type count, const value_type& value )
+template<typename T, typename Allocator>
+void list<T, Allocator>::reset_sentinel() noexcept
+{
+    if (m_size == 0)
+    {
+        m_sentinel.prev = &m_sentinel;
+        m_sentinel.next = &m_sentinel;
+    }
+    else
+    {
+        m_sentinel.prev->next = &m_sentinel;
+        m_sentinel.next->prev = &m_sentinel;
+    }
+}
+
+template<typename T, typename Allocator>
+void list<T, Allocator>::swap( list<T, Allocator>& other )
+{
+    swap_nodes(other);
+
+    if constexpr (std::allocator_traits<node_allocator_type>::propagate_on_container_swap::value)
+    {
+        std::swap(m_allocator, other.m_allocator);
+    }
+}
+
+template<typename T, typename Allocator>
+void list<T, Allocator>::resize( size_type count, const value_type& value )
 {
     if (count < size())
     {
@@ -254,8 +409,8 @@ void list<T>::resize( size_type count, const value_type& value )
     }
 }
 
-template<typename T>
-typename list<T>::iterator list<T>::insert( const_iterator pos, size_type count, const T& value )
+template<typename T, typename Allocator>
+typename list<T, Allocator>::iterator list<T, Allocator>::insert( const_iterator pos, size_type count, const T& value )
 {
     for (size_type i = 0; i < count; ++i)
     {
@@ -265,9 +420,9 @@ typename list<T>::iterator list<T>::insert( const_iterator pos, size_type count,
     return unconst_iterator(pos);
 }
 
-template<typename T>
+template<typename T, typename Allocator>
 template<class InputIt, std::enable_if_t<std::is_same_v<T, typename std::remove_const<typename std::iterator_traits<InputIt>::value_type>::type>, int>>
-typename list<T>::iterator list<T>::insert( const_iterator pos, InputIt first, InputIt last )
+typename list<T, Allocator>::iterator list<T, Allocator>::insert( const_iterator pos, InputIt first, InputIt last )
 {
     auto it = std::make_reverse_iterator(last);
     auto itEnd = std::make_reverse_iterator(first);
@@ -280,194 +435,414 @@ typename list<T>::iterator list<T>::insert( const_iterator pos, InputIt first, I
     return unconst_iterator(pos);
 }
 
-template<typename T>
-void list<T>::reverse()
+template<typename T, typename Allocator>
+void list<T, Allocator>::reverse()
 {
-    _node* node = m_head;
-    while (node)
+    // Sentinel is reversed too, so head and tail are swapped
+    _node_base* node = &m_sentinel;
+    do
     {
         std::swap(node->prev, node->next);
         node = node->prev;
     }
-
-    std::swap(m_head, m_tail);
+    while (node != &m_sentinel);
 }
 
-template<typename T>
-typename list<T>::iterator list<T>::insert_impl(const_iterator pos, _node* newItem)
+template<typename T, typename Allocator>
+typename list<T, Allocator>::iterator list<T, Allocator>::insert_impl(const_iterator pos, _node* newItem)
 {
-    _node* prev = (pos == end()) ? m_tail : pos.m_node->prev;
-    _node* next = (pos == end()) ? nullptr : pos.m_node;
+    _node_base* next = pos.m_node;
+    _node_base* prev = next->prev;
 
-    // Adjust the pointer to the previous item
+    // Neighbours always exist, at least the sentinel
     newItem->prev = prev;
-    if (prev)
-    {
-        prev->next = newItem;
-    }
-
-    // Adjust the pointer to the next item
     newItem->next = next;
-    if (next)
-    {
-        next->prev = newItem;
-    }
+    prev->next = newItem;
+    next->prev = newItem;
+
+    ++m_size;
+    return iterator(newItem);
+}
 
-    // Update the tail pointer
-    if (prev == m_tail)
+template<typename T, typename Allocator>
+typename list<T, Allocator>::iterator list<T, Allocator>::erase_impl(const_iterator pos, size_type count)
+{
+    for (size_t i = 0; i < count ; ++i)
     {
-        m_tail = newItem;
+        const_iterator it = pos++;
+        _node* node = extract_node(it);
+        destroy(node);
     }
 
-    // Update the head pointer
-    if (next == m_head)
+    return unconst_iterator(pos);
+}
+
+template<typename T, typename Allocator>
+void list<T, Allocator>::splice_impl( const_iterator pos, list& other )
+{
+    if (this == &other || other.empty())
+        return;
+
+    if (m_allocator != other.m_allocator)
     {
-        m_head = newItem;
+        // Our allocator can't release nodes of the other list,
+        // so the items must be moved into new nodes.
+        insert(pos, std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        other.clear();
+        return;
     }
 
-    ++m_size;
-    return iterator(this, newItem);
+    // Whole list is relinked at once, we know its size
+    _node_base* first = other.m_sentinel.next;
+    _node_base* last = other.m_sentinel.prev;
+    const size_type count = other.m_size;
+
+    other.unlink_nodes(first, last, count);
+    link_nodes(pos.m_node, first, last, count);
 }
 
-template<typename T>
-typename list<T>::iterator list<T>::erase_impl(const_iterator pos, size_type count)
+template<typename T, typename Allocator>
+void list<T, Allocator>::splice_impl(const_iterator pos, list& other, const_iterator it)
 {
-    for (size_t i = 0; i < count ; ++i)
+    if (it == other.end() || pos == it)
+        return;
+
+    if (m_allocator != other.m_allocator)
     {
-        const_iterator it = pos++;
-        _node* node = extract_node(it);
-        delete node;
+        insert(pos, std::move(*other.unconst_iterator(it)));
+        other.erase(it);
+        return;
     }
 
-    return unconst_iterator(pos);
+    _node_base* node = it.m_node;
+    other.unlink_nodes(node, node, 1);
+    link_nodes(pos.m_node, node, node, 1);
 }
 
-template<typename T>
-void list<T>::splice_impl( const_iterator pos, list& other )
+template<typename T, typename Allocator>
+void list<T, Allocator>::splice_impl(const_iterator pos, list& other, const_iterator it1, const_iterator it2)
 {
-    while (!other.empty())
+    if (it1 == it2)
+        return;
+
+    if (m_allocator != other.m_allocator)
     {
-        _node* node = other.extract_node(other.begin());
-        insert_impl(pos, node);
+        insert(pos, std::make_move_iterator(other.unconst_iterator(it1)), std::make_move_iterator(other.unconst_iterator(it2)));
+        other.erase(it1, it2);
+        return;
     }
+
+    _node_base* first = it1.m_node;
+    _node_base* last = it2.m_node->prev;
+
+    // Range must be counted only, if items are moved between
+    // different lists. Splice within the same list keeps the size.
+    const size_type count = (this != &other) ? static_cast<size_type>(std::distance(it1, it2)) : 0;
+
+    other.unlink_nodes(first, last, count);
+    link_nodes(pos.m_node, first, last, count);
 }
 
-template<typename T>
-void list<T>::splice_impl(const_iterator pos, list& other, const_iterator it)
+template<typename T, typename Allocator>
+void list<T, Allocator>::unlink_nodes( _node_base* first, _node_base* last, size_type count )
+{
+    // Connect the neighbours of the range [first, last] together
+    first->prev->next = last->next;
+    last->next->prev = first->prev;
+    m_size -= count;
+}
+
+template<typename T, typename Allocator>
+void list<T, Allocator>::link_nodes( _node_base* pos, _node_base* first, _node_base* last, size_type count )
+{
+    // Insert the chain [first, last] before the node pos
+    _node_base* prev = pos->prev;
+
+    first->prev = prev;
+    last->next = pos;
+    prev->next = first;
+    pos->prev = last;
+
+    m_size += count;
+}
+
+template<typename T, typename Allocator>
+typename list<T, Allocator>::_node* list<T, Allocator>::extract_node( const_iterator pos )
+{
+    _node_base* node = pos.m_node;
+
+    // Connect the neighbours of the node together, the sentinel
+    // takes care of extracting the first or the last node.
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+
+    --m_size;
+
+    return as_node(node);
+}
+
+template<typename T, typename Allocator>
+template<typename Comparator>
+void list<T, Allocator>::sort( Comparator comp )
 {
-    if (it == other.end())
+    if (size() < 2)
         return;
 
-    _node* node = other.extract_node(it);
-    insert_impl(pos, node);
+    // Chain is terminated by null instead of the sentinel during the sort
+    _node_base* chain = m_sentinel.next;
+    m_sentinel.prev->next = nullptr;
+
+    auto compareNodes = [&comp](_node_base* left, _node_base* right) { return comp(as_node(left)->value, as_node(right)->value); };
+
+    try
+    {
+        node_chain_sorter<_node_base>::sort(chain, compareNodes);
+    }
+    catch (...)
+    {
+        // Comparator has thrown, the chain contains all nodes again
+        relink_nodes(chain);
+        throw;
+    }
+
+    relink_nodes(chain);
 }
 
-template<typename T>
-void list<T>::splice_impl(const_iterator pos, list& other, const_iterator it1, const_iterator it2)
+template<typename T, typename Allocator>
+void list<T, Allocator>::relink_nodes( _node_base* chain ) noexcept
 {
-    while (it1 != it2)
+    // Restore previous pointers and close the circle
+    // by the sentinel, size remains the same.
+    _node_base* prev = &m_sentinel;
+    for (_node_base* node = chain; node; node = node->next)
     {
-        const_iterator it = it1++;
-        _node* node = other.extract_node(it);
-        insert_impl(pos, node);
+        node->prev = prev;
+        prev->next = node;
+        prev = node;
     }
+
+    prev->next = &m_sentinel;
+    m_sentinel.prev = prev;
 }
 
-template<typename T>
-typename list<T>::_node* list<T>::extract_node( const_iterator pos )
+template<typename T, typename Allocator>
+template<typename Comparator>
+void list<T, Allocator>::parallel_sort( Comparator comp, size_type maxThreadCount )
 {
-    _node* node = pos.m_node;
+    // Small lists are not worth the threads
+    constexpr size_type minChunkSize = 16384;
+    const size_type threadCount = std::min(maxThreadCount, size() / minChunkSize);
 
-    // Adjust the next node's pointer to the previous node
-    if (node->prev)
+    if (threadCount < 2)
     {
-        node->prev->next = node->next;
+        sort(comp);
+        return;
     }
 
-    // Adjust the previous node's pointer to the next node
-    if (node->next)
+    auto compareNodes = [comp](_node_base* left, _node_base* right) mutable { return comp(as_node(left)->value, as_node(right)->value); };
+
+    // List itself is not modified until the pointers are sorted
+    vector<_node_base*> nodes;
+    nodes.reserve(size());
+    for (_node_base* node = m_sentinel.next; node != &m_sentinel; node = node->next)
     {
-        node->next->prev = node->prev;
+        nodes.push_back(node);
     }
 
-    // If the node is the head, then set the head pointer
-    // to the next node (we are deleting from the start)
-    if (m_head == node)
+    vector<_node_base*> buffer(nodes.size());
+    vector<size_type> bounds(threadCount + 1);
+    for (size_type i = 0; i <= threadCount; ++i)
     {
-        m_head = node->next;
+        bounds[i] = i * nodes.size() / threadCount;
     }
 
-    // If the node is the tail, then set the tail pointer
-    // to the previous node (we are deleting from the end)
-    if (m_tail == node)
+    run_parallel(threadCount, [&](size_type index)
+    {
+        auto compare = compareNodes;
+        std::stable_sort(nodes.begin() + bounds[index], nodes.begin() + bounds[index + 1], compare);
+    });
+
+    // Sorted chunks are merged pairwise. Output of every round is split
+    // evenly among the threads, so no thread waits for one large merge.
+    for (size_type width = 1; width < threadCount; width *= 2)
     {
-        m_tail = node->prev;
+        run_parallel(threadCount, [&](size_type index)
+        {
+            auto compare = compareNodes;
+            const size_type outputFirst = bounds[index];
+            const size_type outputLast = bounds[index + 1];
+
+            for (size_type chunk = 0; chunk < threadCount; chunk += 2 * width)
+            {
+                const size_type first = bounds[chunk];
+                const size_type middle = bounds[std::min(chunk + width, threadCount)];
+                const size_type last = bounds[std::min(chunk + 2 * width, threadCount)];
+
+                const size_type from = std::max(first, outputFirst);
+                const size_type to = std::min(last, outputLast);
+
+                if (from >= to)
+                    continue;
+
+                _node_base* const* left = nodes.data() + first;
+                _node_base* const* right = nodes.data() + middle;
+                const size_type leftCount = middle - first;
+                const size_type rightCount = last - middle;
+
+                const size_type leftFrom = merge_split(left, leftCount, right, rightCount, from - first, compare);
+                const size_type leftTo = merge_split(left, leftCount, right, rightCount, to - first, compare);
+                const size_type rightFrom = from - first - leftFrom;
+                const size_type rightTo = to - first - leftTo;
+
+                std::merge(left + leftFrom, left + leftTo, right + rightFrom, right + rightTo, buffer.data() + from, compare);
+            }
+        });
+
+        nodes.swap(buffer);
     }
 
-    --m_size;
+    // Relink the nodes in the sorted order in one pass
+    _node_base* prev = &m_sentinel;
+    for (_node_base* node : nodes)
+    {
+        node->prev = prev;
+        prev->next = node;
+        prev = node;
+    }
 
-    return node;
+    prev->next = &m_sentinel;
+    m_sentinel.prev = prev;
 }
 
-template<typename T>
+template<typename T, typename Allocator>
 template<typename Comparator>
-void list<T>::sort( Comparator comp )
+typename list<T, Allocator>::size_type list<T, Allocator>::merge_split( _node_base* const* first1, size_type count1, _node_base* const* first2, size_type count2, size_type position, Comparator& comp )
 {
-    if (empty() || size() < 2)
-        return;
+    // Returns, how many items of the first range precede the given
+    // position in the stable merge of both ranges (binary search).
+    size_type low = position > count2 ? position - count2 : 0;
+    size_type high = std::min(position, count1);
 
-    list<T> l1;
-    list<T> l2;
-
-    bool swap = false;
-    while (!empty())
+    while (low < high)
     {
-        if (swap)
+        const size_type i = low + (high - low) / 2;
+        const size_type j = position - i;
+
+        if (comp(first2[j - 1], first1[i]))
         {
-            l2.splice(l2.end(), *this, begin());
+            high = i;
         }
         else
         {
-            l1.splice(l2.end(), *this, begin());
+            low = i + 1;
         }
-
-        swap = !swap;
     }
 
-    l1.sort(comp);
-    l2.sort(comp);
-
-    *this = std::move(l1);
-    merge(l2);
+    return low;
 }
 
-template<typename T>
-template<typename Comparator>
-void list<T>::merge_impl( list& other, Comparator comp )
+template<typename T, typename Allocator>
+template<typename Function>
+void list<T, Allocator>::run_parallel( size_type threadCount, Function function )
 {
-    list result;
+    // Task 0 runs on the calling thread. Exceptions are transported
+    // to the calling thread and rethrown after all threads are joined.
+    vector<std::exception_ptr> errors(threadCount);
+    auto task = [&function, &errors](size_type index)
+    {
+        try
+        {
+            function(index);
+        }
+        catch (...)
+        {
+            errors[index] = std::current_exception();
+        }
+    };
 
-    while (!empty() && !other.empty())
+    vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+
+    try
     {
-        if (comp(front(), other.front()))
+        for (size_type i = 1; i < threadCount; ++i)
         {
-            result.splice(result.end(), *this, begin());
+            threads.emplace_back(task, i);
         }
-        else
+    }
+    catch (...)
+    {
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        throw;
+    }
+
+    task(0);
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const std::exception_ptr& error : errors)
+    {
+        if (error)
         {
-            result.splice(result.end(), other, other.begin());
+            std::rethrow_exception(error);
         }
     }
+}
+
+template<typename T, typename Allocator>
+template<typename Comparator>
+void list<T, Allocator>::merge_impl( list& other, Comparator comp )
+{
+    if (this == &other)
+        return;
+
+    if (m_allocator != other.m_allocator)
+    {
+        // Nodes can't be relinked, move the items into
+        // the list using our allocator and merge it.
+        list temporary(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), get_allocator());
+        other.clear();
+        merge_impl(temporary, comp);
+        return;
+    }
+
+    _node_base* node = m_sentinel.next;
+    while (node != &m_sentinel && !other.empty())
+    {
+        if (comp(other.front(), as_node(node)->value))
+        {
+            // Find the whole run of items from the other list, which
+            // belongs before the current node, and relink it at once.
+            _node_base* first = other.m_sentinel.next;
+            _node_base* last = first;
+            size_type count = 1;
+
+            while (last->next != &other.m_sentinel && comp(as_node(last->next)->value, as_node(node)->value))
+            {
+                last = last->next;
+                ++count;
+            }
+
+            other.unlink_nodes(first, last, count);
+            link_nodes(node, first, last, count);
+        }
 
-    result.splice(result.end(), *this);
-    result.splice(result.end(), other);
+        node = node->next;
+    }
 
-    splice(end(), result);
+    splice_impl(end(), other);
 }
 
-template<typename T>
+template<typename T, typename Allocator>
 template<typename UnaryPredicate>
-typename list<T>::size_type list<T>::remove_impl( UnaryPredicate comp )
+typename list<T, Allocator>::size_type list<T, Allocator>::remove_impl( UnaryPredicate comp )
 {
     size_type removedItems = 0;
 
@@ -487,9 +862,9 @@ typename list<T>::size_type list<T>::remove_impl( UnaryPredicate comp )
     return removedItems;
 }
 
-template<typename T>
+template<typename T, typename Allocator>
 template<class BinaryPredicate>
-typename list<T>::size_type list<T>::unique( BinaryPredicate p )
+typename list<T, Allocator>::size_type list<T, Allocator>::unique( BinaryPredicate p )
 {
     if (empty())
         return 0;
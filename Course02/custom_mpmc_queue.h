@@ -0,0 +1,409 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#ifndef CUSTOM_MPMC_QUEUE_H
+#define CUSTOM_MPMC_QUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+
+#include "custom_aligned.h"
+
+namespace course_l01
+{
+
+// Bounded lock-free queue for any number of producer and consumer threads
+// (Dmitry Vyukov's algorithm). Every slot of the power-of-two circular buffer
+// has a sequence number, which tells, whose turn the slot is. Slot at
+// position pos is free for the producer of pos, when sequence == pos, and
+// contains an item for the consumer of pos, when sequence == pos + 1. Producers
+// and consumers claim positions by compare-exchange of the tail and head
+// indices, so they contend on the indices only, not on a lock.
+//
+// Item is constructed after its slot is claimed and the slot can't be
+// given back, so move constructor of T must not throw.
+template<typename T, typename Allocator = std::allocator<T>>
+class mpmc_queue
+{
+    static_assert(std::is_nothrow_move_constructible_v<T>, "Move constructor of T must not throw.");
+
+private:
+    struct _slot;
+    using slot_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<_slot>;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    // Capacity is rounded up to a power of two
+    explicit mpmc_queue( size_type capacity, const Allocator& alloc = Allocator() );
+    mpmc_queue( const mpmc_queue& ) = delete;
+    mpmc_queue& operator=( const mpmc_queue& ) = delete;
+    ~mpmc_queue();
+
+    // Size is exact only if no thread is modifying the queue
+    bool empty() const noexcept { return size() == 0; }
+    size_type size() const noexcept;
+    size_type capacity() const noexcept { return m_capacity; }
+
+    // Non-blocking functions return false, when the queue is full (push)
+    // or empty (pop). Arguments are consumed only on success.
+    bool try_push( const value_type& value ) { return try_emplace(value); }
+    bool try_push( value_type&& value ) { return try_emplace(std::move(value)); }
+    template<typename... Args>
+    bool try_emplace( Args&&... args );
+    bool try_pop( value_type& value );
+
+    // Blocking functions wait until there is a free slot (push)
+    // or an item (pop), the waiting thread yields.
+    void push( const value_type& value ) { emplace(value); }
+    void push( value_type&& value ) { emplace(std::move(value)); }
+    template<typename... Args>
+    void emplace( Args&&... args );
+    void pop( value_type& value );
+
+    // Bulk functions claim up to count consecutive positions by a single
+    // compare-exchange and return number of items pushed or popped. Items
+    // are constructed from *first after the claim, so the construction
+    // must not throw (use std::make_move_iterator for non-trivial types).
+    template<typename InputIt>
+    size_type try_push_n( InputIt first, size_type count );
+    template<typename OutputIt>
+    size_type try_pop_n( OutputIt out, size_type count );
+
+private:
+    struct _slot
+    {
+        std::atomic<size_type> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* item() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    template<typename... Args>
+    bool push_impl( Args&&... args );
+    void release_slot( _slot& slot, size_type position ) noexcept;
+
+    // Shared read-only data
+    slot_allocator_type m_allocator;
+    _slot* m_slots = nullptr;
+    size_type m_capacity = 0;
+    size_type m_mask = 0;
+
+    // Producers and consumers contend on different cache lines
+    alignas(cache_line_size) std::atomic<size_type> m_tail = 0;
+    alignas(cache_line_size) std::atomic<size_type> m_head = 0;
+};
+
+template<typename T, typename Allocator>
+mpmc_queue<T, Allocator>::mpmc_queue( size_type capacity, const Allocator& alloc ) :
+    m_allocator(alloc)
+{
+    m_capacity = 2;
+    while (m_capacity < capacity)
+    {
+        m_capacity *= 2;
+    }
+
+    m_mask = m_capacity - 1;
+    m_slots = std::allocator_traits<slot_allocator_type>::allocate(m_allocator, m_capacity);
+
+    for (size_type i = 0; i < m_capacity; ++i)
+    {
+        ::new (static_cast<void*>(m_slots + i)) _slot();
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T, typename Allocator>
+mpmc_queue<T, Allocator>::~mpmc_queue()
+{
+    const size_type tail = m_tail.load(std::memory_order_acquire);
+    for (size_type head = m_head.load(std::memory_order_acquire); head != tail; ++head)
+    {
+        m_slots[head & m_mask].item()->~T();
+    }
+
+    std::allocator_traits<slot_allocator_type>::deallocate(m_allocator, m_slots, m_capacity);
+}
+
+template<typename T, typename Allocator>
+typename mpmc_queue<T, Allocator>::size_type mpmc_queue<T, Allocator>::size() const noexcept
+{
+    const size_type head = m_head.load(std::memory_order_acquire);
+    const size_type tail = m_tail.load(std::memory_order_acquire);
+
+    // Head can be loaded before a consumer claims the last item
+    return tail > head ? tail - head : 0;
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+bool mpmc_queue<T, Allocator>::try_emplace( Args&&... args )
+{
+    if constexpr (std::is_nothrow_constructible_v<T, Args&&...>)
+    {
+        return push_impl(std::forward<Args>(args)...);
+    }
+    else
+    {
+        // Construction can throw, so the item is constructed before a slot
+        // is claimed. It is moved into the slot without an exception.
+        T item(std::forward<Args>(args)...);
+        return push_impl(std::move(item));
+    }
+}
+
+template<typename T, typename Allocator>
+bool mpmc_queue<T, Allocator>::try_pop( value_type& value )
+{
+    size_type position = m_head.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        _slot& slot = m_slots[position & m_mask];
+        const size_type sequence = slot.sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t difference = std::ptrdiff_t(sequence - (position + 1));
+
+        if (difference == 0)
+        {
+            if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                try
+                {
+                    value = std::move(*slot.item());
+                }
+                catch (...)
+                {
+                    // Slot must be released anyway, item is lost
+                    release_slot(slot, position);
+                    throw;
+                }
+
+                release_slot(slot, position);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            // Producer of this position has not finished yet
+            return false;
+        }
+        else
+        {
+            // Other consumer has taken the position
+            position = m_head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+void mpmc_queue<T, Allocator>::emplace( Args&&... args )
+{
+    if constexpr (std::is_nothrow_constructible_v<T, Args&&...>)
+    {
+        while (!push_impl(std::forward<Args>(args)...))
+        {
+            std::this_thread::yield();
+        }
+    }
+    else
+    {
+        T item(std::forward<Args>(args)...);
+        while (!push_impl(std::move(item)))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+template<typename T, typename Allocator>
+void mpmc_queue<T, Allocator>::pop( value_type& value )
+{
+    while (!try_pop(value))
+    {
+        std::this_thread::yield();
+    }
+}
+
+template<typename T, typename Allocator>
+template<typename InputIt>
+typename mpmc_queue<T, Allocator>::size_type mpmc_queue<T, Allocator>::try_push_n( InputIt first, size_type count )
+{
+    static_assert(std::is_nothrow_constructible_v<T, decltype(*first)>, "Items must be constructed without an exception.");
+
+    // Nothing can be claimed, the loop below would never end
+    if (count == 0)
+        return 0;
+
+    size_type position = m_tail.load(std::memory_order_relaxed);
+    size_type claimed = 0;
+
+    for (;;)
+    {
+        // Count the free slots following the position. Their sequence
+        // numbers can't change until they are claimed and filled.
+        claimed = 0;
+        while (claimed < count && m_slots[(position + claimed) & m_mask].sequence.load(std::memory_order_acquire) == position + claimed)
+        {
+            ++claimed;
+        }
+
+        if (claimed == 0)
+        {
+            const size_type sequence = m_slots[position & m_mask].sequence.load(std::memory_order_acquire);
+            if (std::ptrdiff_t(sequence - position) < 0)
+            {
+                return 0;
+            }
+
+            position = m_tail.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        if (m_tail.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+
+    for (size_type i = 0; i < claimed; ++i, ++first)
+    {
+        _slot& slot = m_slots[(position + i) & m_mask];
+        ::new (static_cast<void*>(slot.storage)) T(*first);
+        slot.sequence.store(position + i + 1, std::memory_order_release);
+    }
+
+    return claimed;
+}
+
+template<typename T, typename Allocator>
+template<typename OutputIt>
+typename mpmc_queue<T, Allocator>::size_type mpmc_queue<T, Allocator>::try_pop_n( OutputIt out, size_type count )
+{
+    if (count == 0)
+        return 0;
+
+    size_type position = m_head.load(std::memory_order_relaxed);
+    size_type claimed = 0;
+
+    for (;;)
+    {
+        claimed = 0;
+        while (claimed < count && m_slots[(position + claimed) & m_mask].sequence.load(std::memory_order_acquire) == position + claimed + 1)
+        {
+            ++claimed;
+        }
+
+        if (claimed == 0)
+        {
+            const size_type sequence = m_slots[position & m_mask].sequence.load(std::memory_order_acquire);
+            if (std::ptrdiff_t(sequence - (position + 1)) < 0)
+            {
+                return 0;
+            }
+
+            position = m_head.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        if (m_head.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+
+    size_type i = 0;
+
+    try
+    {
+        for (; i < claimed; ++i, ++out)
+        {
+            _slot& slot = m_slots[(position + i) & m_mask];
+            *out = std::move(*slot.item());
+            release_slot(slot, position + i);
+        }
+    }
+    catch (...)
+    {
+        // All claimed slots must be released, remaining items are lost
+        for (; i < claimed; ++i)
+        {
+            release_slot(m_slots[(position + i) & m_mask], position + i);
+        }
+
+        throw;
+    }
+
+    return claimed;
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+bool mpmc_queue<T, Allocator>::push_impl( Args&&... args )
+{
+    size_type position = m_tail.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        _slot& slot = m_slots[position & m_mask];
+        const size_type sequence = slot.sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t difference = std::ptrdiff_t(sequence - position);
+
+        if (difference == 0)
+        {
+            if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                ::new (static_cast<void*>(slot.storage)) T(std::forward<Args>(args)...);
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            // Consumer of the previous round has not finished yet
+            return false;
+        }
+        else
+        {
+            // Other producer has taken the position
+            position = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename T, typename Allocator>
+void mpmc_queue<T, Allocator>::release_slot( _slot& slot, size_type position ) noexcept
+{
+    // Slot becomes free for the producer of the next round
+    slot.item()->~T();
+    slot.sequence.store(position + m_capacity, std::memory_order_release);
+}
+
+}   // namespace course_l01
+
+#endif // CUSTOM_MPMC_QUEUE_H
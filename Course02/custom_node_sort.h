@@ -0,0 +1,197 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#ifndef CUSTOM_NODE_SORT_H
+#define CUSTOM_NODE_SORT_H
+
+#include <cstddef>
+#include <utility>
+
+namespace course_l01
+{
+
+// Stable merge sort of a null terminated chain of nodes linked by the next
+// pointer only, it is shared by the linked lists. Node comparator gets
+// two node pointers. If the comparator throws, the chain again contains
+// all nodes (in unspecified order) and the exception is propagated.
+template<typename Node>
+class node_chain_sorter
+{
+public:
+    template<typename NodeComparator>
+    static void sort( Node*& chain, NodeComparator comp );
+
+private:
+    template<typename NodeComparator>
+    static Node* take_run( Node*& chain, NodeComparator& comp );
+    template<typename NodeComparator>
+    static void merge_nodes( Node*& left, Node* right, NodeComparator& comp );
+    static Node* concat_nodes( Node* first, Node* second );
+};
+
+template<typename Node>
+template<typename NodeComparator>
+void node_chain_sorter<Node>::sort( Node*& chain, NodeComparator comp )
+{
+    // Bottom-up merge sort. Sorted runs are taken from the chain and
+    // merged like in a binary counter: bin i holds a sorted chain
+    // made from 2^i runs. No memory is allocated and no recursion is used.
+    constexpr std::size_t binCount = 64;
+    Node* bins[binCount] = { };
+    Node* rest = chain;
+    Node* carry = nullptr;
+    Node* result = nullptr;
+
+    try
+    {
+        while (rest)
+        {
+            carry = take_run(rest, comp);
+
+            std::size_t i = 0;
+            for (; i < binCount - 1 && bins[i]; ++i)
+            {
+                // Older run is on the left, so the sort is stable
+                merge_nodes(bins[i], std::exchange(carry, nullptr), comp);
+                carry = std::exchange(bins[i], nullptr);
+            }
+
+            merge_nodes(bins[i], std::exchange(carry, nullptr), comp);
+        }
+
+        for (Node*& bin : bins)
+        {
+            merge_nodes(bin, std::exchange(result, nullptr), comp);
+            result = std::exchange(bin, nullptr);
+        }
+    }
+    catch (...)
+    {
+        // Comparator has thrown, return all nodes back to the chain
+        chain = concat_nodes(result, concat_nodes(carry, rest));
+        for (Node* bin : bins)
+        {
+            chain = concat_nodes(bin, chain);
+        }
+
+        throw;
+    }
+
+    chain = result;
+}
+
+template<typename Node>
+template<typename NodeComparator>
+Node* node_chain_sorter<Node>::take_run( Node*& chain, NodeComparator& comp )
+{
+    Node* first = chain;
+    Node* last = first;
+
+    if (last->next && comp(last->next, last))
+    {
+        // Strictly descending run is reversed, equal items
+        // are not part of it, so the order of equal items is kept.
+        Node* run = first;
+        chain = first->next;
+        first->next = nullptr;
+
+        try
+        {
+            while (chain && comp(chain, run))
+            {
+                Node* node = chain;
+                chain = chain->next;
+                node->next = run;
+                run = node;
+            }
+        }
+        catch (...)
+        {
+            first->next = chain;
+            chain = run;
+            throw;
+        }
+
+        return run;
+    }
+
+    while (last->next && !comp(last->next, last))
+    {
+        last = last->next;
+    }
+
+    chain = last->next;
+    last->next = nullptr;
+    return first;
+}
+
+template<typename Node>
+template<typename NodeComparator>
+void node_chain_sorter<Node>::merge_nodes( Node*& left, Node* right, NodeComparator& comp )
+{
+    // Result is stored in the left chain. Items from the left chain
+    // precede equal items from the right chain.
+    Node** tail = &left;
+
+    try
+    {
+        while (*tail && right)
+        {
+            if (comp(right, *tail))
+            {
+                Node* node = right;
+                right = right->next;
+                node->next = *tail;
+                *tail = node;
+            }
+
+            tail = &(*tail)->next;
+        }
+    }
+    catch (...)
+    {
+        left = concat_nodes(left, right);
+        throw;
+    }
+
+    if (right)
+    {
+        *tail = right;
+    }
+}
+
+template<typename Node>
+Node* node_chain_sorter<Node>::concat_nodes( Node* first, Node* second )
+{
+    if (!first)
+        return second;
+
+    Node* last = first;
+    while (last->next)
+    {
+        last = last->next;
+    }
+
+    last->next = second;
+    return first;
+}
+
+} // namespace course_l01
+
+#endif // CUSTOM_NODE_SORT_H
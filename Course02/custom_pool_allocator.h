@@ -0,0 +1,239 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+
+#ifndef CUSTOM_POOL_ALLOCATOR_H
+#define CUSTOM_POOL_ALLOCATOR_H
+
+#include <new>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+namespace course_l01
+{
+
+// Pool of fixed-size memory blocks. Memory is allocated in large slabs,
+// blocks are carved from the current slab, and released blocks are
+// recycled through a free list, so allocation and deallocation of a block
+// is just a few pointer operations. Slabs are released, when the pool is
+// destroyed. Pool is not thread safe.
+class node_pool
+{
+public:
+    node_pool( std::size_t blockSize, std::size_t blockAlignment, std::size_t blocksPerSlab );
+    node_pool( const node_pool& ) = delete;
+    node_pool& operator=( const node_pool& ) = delete;
+    ~node_pool();
+
+    void* allocate();
+    void deallocate( void* block ) noexcept;
+
+    std::size_t block_size() const noexcept { return m_blockSize; }
+    std::size_t block_alignment() const noexcept { return m_blockAlignment; }
+    std::size_t slab_count() const noexcept { return m_slabCount; }
+
+private:
+    struct _free_block
+    {
+        _free_block* next;
+    };
+
+    struct _slab
+    {
+        _slab* next;
+    };
+
+    void allocate_slab();
+
+    std::size_t m_blockSize = 0;
+    std::size_t m_blockAlignment = 0;
+    std::size_t m_blocksPerSlab = 0;
+    std::size_t m_slabHeaderSize = 0;
+    std::size_t m_slabCount = 0;
+    _free_block* m_freeList = nullptr;
+    _slab* m_slabs = nullptr;
+    unsigned char* m_current = nullptr;
+    unsigned char* m_end = nullptr;
+};
+
+inline node_pool::node_pool( std::size_t blockSize, std::size_t blockAlignment, std::size_t blocksPerSlab ) :
+    m_blocksPerSlab(blocksPerSlab > 0 ? blocksPerSlab : 1)
+{
+    // Each released block holds the pointer to the next free block,
+    // so the block must be large enough and aligned for it.
+    m_blockAlignment = std::max(blockAlignment, alignof(_free_block));
+    m_blockAlignment = std::max(m_blockAlignment, alignof(_slab));
+    m_blockSize = std::max(blockSize, sizeof(_free_block));
+    m_blockSize = (m_blockSize + m_blockAlignment - 1) / m_blockAlignment * m_blockAlignment;
+    m_slabHeaderSize = (sizeof(_slab) + m_blockAlignment - 1) / m_blockAlignment * m_blockAlignment;
+}
+
+inline node_pool::~node_pool()
+{
+    while (m_slabs)
+    {
+        _slab* slab = m_slabs;
+        m_slabs = slab->next;
+        ::operator delete(static_cast<void*>(slab), std::align_val_t(m_blockAlignment));
+    }
+}
+
+inline void* node_pool::allocate()
+{
+    // Recycle the most recently released block first, it is likely in cache
+    if (m_freeList)
+    {
+        _free_block* block = m_freeList;
+        m_freeList = block->next;
+        return block;
+    }
+
+    if (m_current == m_end)
+    {
+        allocate_slab();
+    }
+
+    void* block = m_current;
+    m_current += m_blockSize;
+    return block;
+}
+
+inline void node_pool::deallocate( void* block ) noexcept
+{
+    _free_block* freeBlock = ::new (block) _free_block;
+    freeBlock->next = m_freeList;
+    m_freeList = freeBlock;
+}
+
+inline void node_pool::allocate_slab()
+{
+    // Slab header is at the start of the slab, blocks follow it.
+    // Blocks are carved lazily, so untouched memory is not written.
+    const std::size_t size = m_slabHeaderSize + m_blocksPerSlab * m_blockSize;
+    unsigned char* memory = static_cast<unsigned char*>(::operator new(size, std::align_val_t(m_blockAlignment)));
+
+    _slab* slab = ::new (memory) _slab;
+    slab->next = m_slabs;
+    m_slabs = slab;
+    ++m_slabCount;
+
+    m_current = memory + m_slabHeaderSize;
+    m_end = memory + size;
+}
+
+// Set of node pools for different block sizes. Allocators rebound
+// to different types share the resource, each type uses the pool
+// for its size and alignment.
+class pool_resource
+{
+public:
+    explicit pool_resource( std::size_t blocksPerSlab = 256 ) : m_blocksPerSlab(blocksPerSlab) { }
+
+    node_pool& get_pool( std::size_t blockSize, std::size_t blockAlignment )
+    {
+        for (const _pool_entry& entry : m_pools)
+        {
+            if (entry.blockSize == blockSize && entry.blockAlignment == blockAlignment)
+                return *entry.pool;
+        }
+
+        m_pools.push_back({ blockSize, blockAlignment, std::make_unique<node_pool>(blockSize, blockAlignment, m_blocksPerSlab) });
+        return *m_pools.back().pool;
+    }
+
+private:
+    struct _pool_entry
+    {
+        std::size_t blockSize;
+        std::size_t blockAlignment;
+        std::unique_ptr<node_pool> pool;
+    };
+
+    std::size_t m_blocksPerSlab;
+    std::vector<_pool_entry> m_pools;
+};
+
+// Returns the pool resource used by default-constructed pool allocators,
+// similarly to std::pmr::get_default_resource. Resource is not thread
+// safe, so each thread has its own default resource.
+inline const std::shared_ptr<pool_resource>& default_pool_resource()
+{
+    thread_local const std::shared_ptr<pool_resource> resource = std::make_shared<pool_resource>();
+    return resource;
+}
+
+// Allocator, which allocates single objects (for example list nodes)
+// from the node pool. Arrays are allocated by std::allocator. Copies
+// of the allocator (also rebound ones) share the same pool resource,
+// so they compare equal and can release memory of each other. Default
+// constructed allocators of one thread share the default pool resource.
+template<typename T>
+class pool_allocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    pool_allocator() : pool_allocator(default_pool_resource()) { }
+    explicit pool_allocator( std::shared_ptr<pool_resource> resource ) :
+        m_resource(std::move(resource)),
+        m_pool(&m_resource->get_pool(sizeof(T), alignof(T)))
+    {
+
+    }
+
+    template<typename U>
+    pool_allocator( const pool_allocator<U>& other ) : pool_allocator(other.get_resource()) { }
+
+    T* allocate( std::size_t n )
+    {
+        if (n == 1)
+            return static_cast<T*>(m_pool->allocate());
+
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate( T* p, std::size_t n ) noexcept
+    {
+        if (n == 1)
+            m_pool->deallocate(p);
+        else
+            std::allocator<T>().deallocate(p, n);
+    }
+
+    const std::shared_ptr<pool_resource>& get_resource() const noexcept { return m_resource; }
+
+    template<typename U>
+    bool operator==( const pool_allocator<U>& other ) const noexcept { return m_resource == other.get_resource(); }
+    template<typename U>
+    bool operator!=( const pool_allocator<U>& other ) const noexcept { return m_resource != other.get_resource(); }
+
+private:
+    std::shared_ptr<pool_resource> m_resource;
+    node_pool* m_pool = nullptr;
+};
+
+}   // namespace course_l01
+
+#endif // CUSTOM_POOL_ALLOCATOR_H
@@ -20,12 +20,12 @@
 #ifndef CUSTOM_QUEUE_H
 #define CUSTOM_QUEUE_H
 
-#include "custom_list.h"
+#include "custom_ring_buffer.h"
 
 namespace course_l01
 {
 
-template<typename T, class Container = list<T>>
+template<typename T, class Container = ring_buffer<T>>
 class queue
 {
 public:
@@ -0,0 +1,543 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#ifndef CUSTOM_RING_BUFFER_H
+#define CUSTOM_RING_BUFFER_H
+
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+#include <algorithm>
+
+#include "custom_vector.h"
+
+namespace course_l01
+{
+
+// Double-ended queue stored in one contiguous circular buffer. Capacity
+// is always a power of two, so the position of an item is computed by
+// masking instead of division. Items are pushed and popped at both ends
+// in O(1) without allocation, buffer grows by doubling, when it is full.
+template<typename T, typename Allocator = std::allocator<T>>
+class ring_buffer
+{
+public:
+    // Type declarations
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = typename std::allocator_traits<allocator_type>::size_type;
+    using difference_type = typename std::allocator_traits<allocator_type>::difference_type;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename std::allocator_traits<allocator_type>::pointer;
+    using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+
+    ring_buffer() = default;
+    explicit ring_buffer( const Allocator& alloc ) noexcept : m_allocator(alloc) { }
+    explicit ring_buffer( size_type count, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { resize(count); }
+    template< class InputIt >
+    ring_buffer( InputIt first, InputIt last, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { append(first, last); }
+    ring_buffer( const ring_buffer& other );
+    ring_buffer( ring_buffer&& other ) noexcept : m_allocator(std::move(other.m_allocator)) { take_storage(other); }
+    ring_buffer( std::initializer_list<T> init, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { append(init.begin(), init.end()); }
+    ~ring_buffer();
+
+    // Assignment operator
+    ring_buffer& operator=( const ring_buffer& other );
+    ring_buffer& operator=( ring_buffer&& other );
+
+    // Assign methods
+    void assign( size_type count, const T& value ) { clear(); resize(count, value); }
+    template< class InputIt, std::enable_if_t<std::is_same_v<T, typename std::iterator_traits<InputIt>::value_type>, int> = 0 >
+    void assign( InputIt first, InputIt last ) { clear(); append(first, last); }
+    void assign( std::initializer_list<T> ilist ) { assign(ilist.begin(), ilist.end()); }
+
+    // Iterator remembers the position unwrapped (head + index),
+    // it is masked only when the item is accessed.
+    template<typename Value>
+    class _iterator
+    {
+    public:
+        using value_type = std::remove_const_t<Value>;
+        using reference = Value&;
+        using pointer = Value*;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+
+        _iterator() = default;
+        _iterator( Value* data, size_type mask, size_type position ) : m_data(data), m_mask(mask), m_position(position) { }
+
+        reference operator*() const { return m_data[m_position & m_mask]; }
+        pointer operator->() const { return &m_data[m_position & m_mask]; }
+        reference operator[]( difference_type offset ) const { return m_data[(m_position + offset) & m_mask]; }
+
+        _iterator& operator++() { ++m_position; return *this; }
+        _iterator operator++(int) { _iterator temp = *this; ++m_position; return temp; }
+        _iterator& operator--() { --m_position; return *this; }
+        _iterator operator--(int) { _iterator temp = *this; --m_position; return temp; }
+        _iterator& operator+=( difference_type offset ) { m_position += offset; return *this; }
+        _iterator& operator-=( difference_type offset ) { m_position -= offset; return *this; }
+        _iterator operator+( difference_type offset ) const { return _iterator(m_data, m_mask, m_position + offset); }
+        _iterator operator-( difference_type offset ) const { return _iterator(m_data, m_mask, m_position - offset); }
+        friend _iterator operator+( difference_type offset, const _iterator& it ) { return it + offset; }
+        difference_type operator-( const _iterator& other ) const { return difference_type(m_position - other.m_position); }
+
+        bool operator==( const _iterator& other ) const { return m_position == other.m_position; }
+        bool operator!=( const _iterator& other ) const { return m_position != other.m_position; }
+        bool operator<( const _iterator& other ) const { return *this - other < 0; }
+        bool operator>( const _iterator& other ) const { return other < *this; }
+        bool operator<=( const _iterator& other ) const { return !(other < *this); }
+        bool operator>=( const _iterator& other ) const { return !(*this < other); }
+
+        operator _iterator<const Value>() const { return _iterator<const Value>(m_data, m_mask, m_position); }
+
+    private:
+        Value* m_data = nullptr;
+        size_type m_mask = 0;
+        size_type m_position = 0;
+    };
+
+    using iterator = _iterator<value_type>;
+    using const_iterator = _iterator<const value_type>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Element access
+    reference at( size_type pos );
+    const_reference at( size_type pos ) const;
+
+    reference operator[]( size_type pos ) noexcept { return m_data[(m_head + pos) & mask()]; }
+    const_reference operator[]( size_type pos ) const noexcept { return m_data[(m_head + pos) & mask()]; }
+
+    reference front() noexcept { return m_data[m_head]; }
+    const_reference front() const noexcept { return m_data[m_head]; }
+
+    reference back() noexcept { return (*this)[m_size - 1]; }
+    const_reference back() const noexcept { return (*this)[m_size - 1]; }
+
+    // Iterators
+
+    iterator begin() noexcept { return iterator(data(), mask(), m_head); }
+    const_iterator begin() const noexcept { return const_iterator(data(), mask(), m_head); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(data(), mask(), m_head + m_size); }
+    const_iterator end() const noexcept { return const_iterator(data(), mask(), m_head + m_size); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return std::make_reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return std::make_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return std::make_reverse_iterator(cend()); }
+
+    reverse_iterator rend() noexcept { return std::make_reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return std::make_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return std::make_reverse_iterator(cbegin()); }
+
+    // Capacity methods
+    bool empty() const noexcept { return m_size == 0; }
+    size_type size() const noexcept { return m_size; }
+    size_type max_size() const noexcept { return std::allocator_traits<allocator_type>::max_size(m_allocator); }
+    size_type capacity() const noexcept { return m_capacity; }
+    void reserve( size_type new_capacity );
+    void shrink_to_fit();
+    void resize( size_type count ) { resize_impl(count); }
+    void resize( size_type count, const value_type& value ) { resize_impl(count, value); }
+
+    // Modifiers
+    void clear() noexcept;
+    void swap( ring_buffer& other );
+
+    void push_back( const value_type& item ) { emplace_back(item); }
+    void push_back( value_type&& item ) { emplace_back(std::move(item)); }
+    void push_front( const value_type& item ) { emplace_front(item); }
+    void push_front( value_type&& item ) { emplace_front(std::move(item)); }
+
+    void pop_front() noexcept;
+    void pop_back() noexcept;
+
+    // Emplace
+    template<typename... Args>
+    reference emplace_back( Args&&... args );
+    template<typename... Args>
+    reference emplace_front( Args&&... args );
+
+    allocator_type get_allocator() const { return m_allocator; }
+
+private:
+    static constexpr size_type min_capacity = 8;
+
+    size_type mask() const noexcept { return m_capacity - 1; }
+    T* data() const noexcept { return m_data ? std::addressof(*m_data) : nullptr; }
+    size_type next_capacity( size_type newSize ) const;
+
+    template<typename InputIt>
+    void append( InputIt first, InputIt last );
+    template<typename... Args>
+    void resize_impl( size_type count, const Args&... args );
+    template<typename... Args>
+    pointer grow_emplace( bool atFront, Args&&... args );
+    void reallocate( size_type newCapacity );
+    void relocate( pointer destination );
+    void release_storage() noexcept;
+    void take_storage( ring_buffer& other ) noexcept;
+
+    allocator_type m_allocator;
+    pointer m_data = nullptr;
+    size_type m_capacity = 0;
+    size_type m_head = 0;
+    size_type m_size = 0;
+};
+
+template<typename T, typename Allocator>
+ring_buffer<T, Allocator>::ring_buffer( const ring_buffer& other ) :
+    m_allocator(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.m_allocator))
+{
+    reserve(other.size());
+    append(other.begin(), other.end());
+}
+
+template<typename T, typename Allocator>
+ring_buffer<T, Allocator>::~ring_buffer()
+{
+    release_storage();
+}
+
+template<typename T, typename Allocator>
+ring_buffer<T, Allocator>& ring_buffer<T, Allocator>::operator=( const ring_buffer& other )
+{
+    if (this == &other)
+        return *this;
+
+    if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value)
+    {
+        // Storage must be released by the allocator which allocated it
+        if (m_allocator != other.m_allocator)
+        {
+            release_storage();
+        }
+
+        m_allocator = other.m_allocator;
+    }
+
+    clear();
+    reserve(other.size());
+    append(other.begin(), other.end());
+    return *this;
+}
+
+template<typename T, typename Allocator>
+ring_buffer<T, Allocator>& ring_buffer<T, Allocator>::operator=( ring_buffer&& other )
+{
+    if (this == &other)
+        return *this;
+
+    if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value)
+    {
+        release_storage();
+        m_allocator = std::move(other.m_allocator);
+        take_storage(other);
+    }
+    else if (m_allocator == other.m_allocator)
+    {
+        release_storage();
+        take_storage(other);
+    }
+    else
+    {
+        // We can't take the storage of the other buffer, so move the items
+        clear();
+        reserve(other.size());
+        append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    }
+
+    return *this;
+}
+
+template<typename T, typename Allocator>
+typename ring_buffer<T, Allocator>::reference ring_buffer<T, Allocator>::at( size_type pos )
+{
+    if (pos >= size())
+    {
+        throw std::out_of_range("Index out of range.");
+    }
+
+    return (*this)[pos];
+}
+
+template<typename T, typename Allocator>
+typename ring_buffer<T, Allocator>::const_reference ring_buffer<T, Allocator>::at( size_type pos ) const
+{
+    if (pos >= size())
+    {
+        throw std::out_of_range("Index out of range.");
+    }
+
+    return (*this)[pos];
+}
+
+template<typename T, typename Allocator>
+void ring_buffer<T, Allocator>::reserve( size_type new_capacity )
+{
+    if (new_capacity > capacity())
+    {
+        reallocate(next_capacity(new_capacity));
+    }
+}
+
+template<typename T, typename Allocator>
+void ring_buffer<T, Allocator>::shrink_to_fit()
+{
+    if (empty())
+    {
+        release_storage();
+        return;
+    }
+
+    size_type newCapacity = min_capacity;
+    while (newCapacity < size())
+    {
+        newCapacity *= 2;
+    }
+
+    if (newCapacity < capacity())
+    {
+        reallocate(newCapacity);
+    }
+}
+
+template<typename T, typename Allocator>
+void ring_buffer<T, Allocator>::clear() noexcept
+{
+    while (!empty())
+    {
+        pop_back();
+    }
+
+    m_head = 0;
+}
+
+template<typename T, typename Allocator>
+void ring_buffer<T, Allocator>::swap( ring_buffer& other )
+{
+    if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value)
+    {
+        std::swap(m_allocator, other.m_allocator);
+    }
+
+    std::swap(m_data, other.m_data);
+    std::swap(m_capacity, other.m_capacity);
+    std::swap(m_head, other.m_head);
+    std::swap(m_size, other.m_size);
+}
+
+template<typename T, typename Allocator>
+void ring_buffer<T, Allocator>::pop_front() noexcept
+{
+    std::allocator_traits<allocator_type>::destroy(m_allocator, m_data + m_head);
+    m_head = (m_head + 1) & mask();
+    --m_size;
+}
+
+template<typename T, typename Allocator>
+void ring_buffer<T, Allocator>::pop_back() noexcept
+{
+    std::allocator_traits<allocator_type>::destroy(m_allocator, m_data + ((m_head + m_size - 1) & mask()));
+    --m_size;
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+typename ring_buffer<T, Allocator>::reference ring_buffer<T, Allocator>::emplace_back( Args&&... args )
+{
+    if (m_size == m_capacity)
+    {
+        return *grow_emplace(false, std::forward<Args>(args)...);
+    }
+
+    pointer item = m_data + ((m_head + m_size) & mask());
+    std::allocator_traits<allocator_type>::construct(m_allocator, item, std::forward<Args>(args)...);
+    ++m_size;
+    return *item;
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+typename ring_buffer<T, Allocator>::reference ring_buffer<T, Allocator>::emplace_front( Args&&... args )
+{
+    if (m_size == m_capacity)
+    {
+        return *grow_emplace(true, std::forward<Args>(args)...);
+    }
+
+    const size_type head = (m_head - 1) & mask();
+    pointer item = m_data + head;
+    std::allocator_traits<allocator_type>::construct(m_allocator, item, std::forward<Args>(args)...);
+    m_head = head;
+    ++m_size;
+    return *item;
+}
+
+template<typename T, typename Allocator>
+typename ring_buffer<T, Allocator>::size_type ring_buffer<T, Allocator>::next_capacity( size_type newSize ) const
+{
+    if (newSize > max_size())
+        throw std::bad_alloc();
+
+    // Capacity must remain a power of two
+    size_type newCapacity = std::max(m_capacity, min_capacity);
+    while (newCapacity < newSize)
+    {
+        newCapacity *= 2;
+    }
+
+    return newCapacity;
+}
+
+template<typename T, typename Allocator>
+template<typename InputIt>
+void ring_buffer<T, Allocator>::append( InputIt first, InputIt last )
+{
+    for (; first != last; ++first)
+    {
+        emplace_back(*first);
+    }
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+void ring_buffer<T, Allocator>::resize_impl( size_type count, const Args&... args )
+{
+    while (count < size())
+    {
+        pop_back();
+    }
+
+    reserve(count);
+
+    while (size() < count)
+    {
+        emplace_back(args...);
+    }
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+typename ring_buffer<T, Allocator>::pointer ring_buffer<T, Allocator>::grow_emplace( bool atFront, Args&&... args )
+{
+    // New item is constructed before the old items are relocated,
+    // so arguments can refer to an item of the buffer itself.
+    const size_type newCapacity = next_capacity(m_size + 1);
+    pointer data = std::allocator_traits<allocator_type>::allocate(m_allocator, newCapacity);
+    pointer item = data + (atFront ? newCapacity - 1 : m_size);
+
+    try
+    {
+        std::allocator_traits<allocator_type>::construct(m_allocator, item, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        std::allocator_traits<allocator_type>::deallocate(m_allocator, data, newCapacity);
+        throw;
+    }
+
+    relocate(data);
+
+    if (m_data)
+    {
+        std::allocator_traits<allocator_type>::deallocate(m_allocator, m_data, m_capacity);
+    }
+
+    // Items are stored from the beginning of the new buffer,
+    // item pushed to the front wraps around to its end.
+    m_data = data;
+    m_capacity = newCapacity;
+    m_head = atFront ? newCapacity - 1 : 0;
+    ++m_size;
+    return item;
+}
+
+template<typename T, typename Allocator>
+void ring_buffer<T, Allocator>::reallocate( size_type newCapacity )
+{
+    pointer data = std::allocator_traits<allocator_type>::allocate(m_allocator, newCapacity);
+    relocate(data);
+
+    if (m_data)
+    {
+        std::allocator_traits<allocator_type>::deallocate(m_allocator, m_data, m_capacity);
+    }
+
+    m_data = data;
+    m_capacity = newCapacity;
+    m_head = 0;
+}
+
+template<typename T, typename Allocator>
+void ring_buffer<T, Allocator>::relocate( pointer destination )
+{
+    // Items are stored in at most two contiguous parts,
+    // from the head to the end of buffer and from its start.
+    const size_type firstCount = std::min(m_size, m_capacity - m_head);
+    const size_type secondCount = m_size - firstCount;
+
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        if (firstCount > 0)
+            std::memcpy(static_cast<void*>(std::addressof(*destination)), static_cast<const void*>(std::addressof(*(m_data + m_head))), firstCount * sizeof(T));
+        if (secondCount > 0)
+            std::memcpy(static_cast<void*>(std::addressof(*(destination + firstCount))), static_cast<const void*>(std::addressof(*m_data)), secondCount * sizeof(T));
+    }
+    else
+    {
+        for (size_type i = 0; i < m_size; ++i)
+        {
+            pointer source = m_data + ((m_head + i) & mask());
+            std::allocator_traits<allocator_type>::construct(m_allocator, destination + i, std::move_if_noexcept(*source));
+            std::allocator_traits<allocator_type>::destroy(m_allocator, source);
+        }
+    }
+}
+
+template<typename T, typename Allocator>
+void ring_buffer<T, Allocator>::release_storage() noexcept
+{
+    clear();
+
+    if (m_data)
+    {
+        std::allocator_traits<allocator_type>::deallocate(m_allocator, m_data, m_capacity);
+    }
+
+    m_data = nullptr;
+    m_capacity = 0;
+}
+
+template<typename T, typename Allocator>
+void ring_buffer<T, Allocator>::take_storage( ring_buffer& other ) noexcept
+{
+    m_data = std::exchange(other.m_data, nullptr);
+    m_capacity = std::exchange(other.m_capacity, 0);
+    m_head = std::exchange(other.m_head, 0);
+    m_size = std::exchange(other.m_size, 0);
+}
+
+}   // namespace course_l01
+
+#endif // CUSTOM_RING_BUFFER_H
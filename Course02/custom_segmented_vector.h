@@ -0,0 +1,376 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#ifndef CUSTOM_SEGMENTED_VECTOR_H
+#define CUSTOM_SEGMENTED_VECTOR_H
+
+#include "custom_vector.h"
+
+namespace course_l01
+{
+
+// Vector, which stores items in fixed-size blocks of 2^BlockShift items.
+// When the vector grows, only a new block is allocated, existing items
+// are never moved, so references and pointers to items stay valid and
+// there is no O(n) copy when the vector grows. Item i is stored in the
+// block i >> BlockShift at the position i & (BlockSize - 1).
+template<typename T, std::size_t BlockShift = 10, typename Allocator = std::allocator<T>>
+class segmented_vector
+{
+public:
+    // Type declarations
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = typename std::allocator_traits<allocator_type>::size_type;
+    using difference_type = typename std::allocator_traits<allocator_type>::difference_type;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename std::allocator_traits<allocator_type>::pointer;
+    using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+
+    static constexpr size_type block_size = size_type(1) << BlockShift;
+    static constexpr size_type block_mask = block_size - 1;
+
+    segmented_vector() = default;
+    explicit segmented_vector( const Allocator& alloc ) : m_allocator(alloc), m_blocks(block_allocator_type(alloc)) { }
+    explicit segmented_vector( size_type count, const Allocator& alloc = Allocator() ) : segmented_vector(alloc) { resize(count); }
+    template< class InputIt >
+    segmented_vector( InputIt first, InputIt last, const Allocator& alloc = Allocator() ) : segmented_vector(alloc) { assign(first, last); }
+    segmented_vector( const segmented_vector& other );
+    segmented_vector( segmented_vector&& other ) noexcept : m_allocator(other.m_allocator), m_blocks(std::move(other.m_blocks)), m_size(std::exchange(other.m_size, 0)) { }
+    segmented_vector( std::initializer_list<T> init, const Allocator& alloc = Allocator() ) : segmented_vector(alloc) { assign(init.begin(), init.end()); }
+    ~segmented_vector();
+
+    // Assignment operator
+    segmented_vector& operator=( const segmented_vector& other );
+    segmented_vector& operator=( segmented_vector&& other );
+
+    // Assign methods
+    void assign( size_type count, const T& value ) { clear(); resize(count, value); }
+    template< class InputIt >
+    void assign( InputIt first, InputIt last ) { clear(); for (; first != last; ++first) emplace_back(*first); }
+    void assign( std::initializer_list<T> ilist ) { assign(ilist.begin(), ilist.end()); }
+
+    template<typename Container, typename Value>
+    class _iterator
+    {
+    public:
+        using value_type = std::remove_const_t<Value>;
+        using reference = Value&;
+        using pointer = Value*;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+
+        _iterator() = default;
+        _iterator(Container* container, size_type index) : m_container(container), m_index(index) { }
+
+        reference operator*() const { return (*m_container)[m_index]; }
+        pointer operator->() const { return &(*m_container)[m_index]; }
+        reference operator[](difference_type n) const { return (*m_container)[m_index + n]; }
+
+        _iterator& operator++() { ++m_index; return *this; }
+        _iterator operator++(int) { _iterator temp = *this; ++(*this); return temp; }
+        _iterator& operator--() { --m_index; return *this; }
+        _iterator operator--(int) { _iterator temp = *this; --(*this); return temp; }
+
+        _iterator& operator+=(difference_type n) { m_index += n; return *this; }
+        _iterator& operator-=(difference_type n) { m_index -= n; return *this; }
+        _iterator operator+(difference_type n) const { return _iterator(m_container, m_index + n); }
+        _iterator operator-(difference_type n) const { return _iterator(m_container, m_index - n); }
+        friend _iterator operator+(difference_type n, const _iterator& it) { return it + n; }
+        difference_type operator-(const _iterator& other) const { return difference_type(m_index) - difference_type(other.m_index); }
+
+        bool operator==(const _iterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const _iterator& other) const { return m_index != other.m_index; }
+        bool operator<(const _iterator& other) const { return m_index < other.m_index; }
+        bool operator>(const _iterator& other) const { return m_index > other.m_index; }
+        bool operator<=(const _iterator& other) const { return m_index <= other.m_index; }
+        bool operator>=(const _iterator& other) const { return m_index >= other.m_index; }
+
+        operator _iterator<const Container, const Value>() const { return _iterator<const Container, const Value>(m_container, m_index); }
+
+    private:
+        Container* m_container = nullptr;
+        size_type m_index = 0;
+    };
+
+    using iterator = _iterator<segmented_vector, value_type>;
+    using const_iterator = _iterator<const segmented_vector, const value_type>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Element access
+    reference at( size_type pos );
+    const_reference at( size_type pos ) const;
+
+    reference operator[]( size_type pos ) { return m_blocks[pos >> BlockShift][pos & block_mask]; }
+    const_reference operator[]( size_type pos ) const { return m_blocks[pos >> BlockShift][pos & block_mask]; }
+
+    reference front() noexcept { return (*this)[0]; }
+    const_reference front() const noexcept { return (*this)[0]; }
+
+    reference back() noexcept { return (*this)[size() - 1]; }
+    const_reference back() const noexcept { return (*this)[size() - 1]; }
+
+    // Iterators
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+    iterator end() noexcept { return iterator(this, m_size); }
+    const_iterator end() const noexcept { return const_iterator(this, m_size); }
+    const_iterator cend() const noexcept { return const_iterator(this, m_size); }
+
+    reverse_iterator rbegin() noexcept { return std::make_reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return std::make_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return std::make_reverse_iterator(cend()); }
+
+    reverse_iterator rend() noexcept { return std::make_reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return std::make_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return std::make_reverse_iterator(cbegin()); }
+
+    // Capacity methods
+    bool empty() const noexcept { return m_size == 0; }
+    size_type size() const noexcept { return m_size; }
+    size_type max_size() const noexcept { return std::allocator_traits<allocator_type>::max_size(m_allocator); }
+    void reserve( size_type new_capacity );
+    size_type capacity() const noexcept { return m_blocks.size() * block_size; }
+    void shrink_to_fit();
+    void resize( size_type count ) { resize(count, value_type()); }
+    void resize( size_type count, const value_type& value );
+
+    // Modifiers
+    void clear();
+    void push_back( const T& item ) { emplace_back(item); }
+    void push_back( T&& item ) { emplace_back(std::move(item)); }
+    void pop_back();
+    void swap( segmented_vector& other );
+
+    // Emplace
+    template<typename... Args>
+    reference emplace_back( Args&&... args );
+
+    allocator_type get_allocator() const { return m_allocator; }
+
+private:
+    using block_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<pointer>;
+
+    allocator_type m_allocator;
+    vector<pointer, block_allocator_type> m_blocks;
+    size_type m_size = 0;
+};
+
+template<typename T, std::size_t BlockShift, typename Allocator>
+segmented_vector<T, BlockShift, Allocator>::segmented_vector( const segmented_vector& other ) :
+    segmented_vector(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.m_allocator))
+{
+    reserve(other.size());
+    assign(other.begin(), other.end());
+}
+
+template<typename T, std::size_t BlockShift, typename Allocator>
+segmented_vector<T, BlockShift, Allocator>::~segmented_vector()
+{
+    clear();
+    shrink_to_fit();
+}
+
+template<typename T, std::size_t BlockShift, typename Allocator>
+segmented_vector<T, BlockShift, Allocator>& segmented_vector<T, BlockShift, Allocator>::operator=( const segmented_vector& other )
+{
+    if (this == &other)
+        return *this;
+
+    if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value)
+    {
+        if (m_allocator != other.m_allocator)
+        {
+            // Blocks must be released by the allocator which
+            // allocated them, so we can't reuse them.
+            clear();
+            shrink_to_fit();
+            m_blocks = vector<pointer, block_allocator_type>(block_allocator_type(other.m_allocator));
+        }
+
+        m_allocator = other.m_allocator;
+    }
+
+    // Keep allocated blocks, so they are reused
+    assign(other.begin(), other.end());
+    return *this;
+}
+
+template<typename T, std::size_t BlockShift, typename Allocator>
+segmented_vector<T, BlockShift, Allocator>& segmented_vector<T, BlockShift, Allocator>::operator=( segmented_vector&& other )
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    if (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value || m_allocator == other.m_allocator)
+    {
+        // We can release blocks of the other vector, so we take them
+        shrink_to_fit();
+
+        if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value)
+        {
+            m_allocator = other.m_allocator;
+        }
+
+        m_blocks = std::move(other.m_blocks);
+        m_size = std::exchange(other.m_size, 0);
+    }
+    else
+    {
+        assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    }
+
+    return *this;
+}
+
+template<typename T, std::size_t BlockShift, typename Allocator>
+typename segmented_vector<T, BlockShift, Allocator>::reference segmented_vector<T, BlockShift, Allocator>::at( size_type pos )
+{
+    if (!(pos < size()))
+        throw std::out_of_range("segmented_vector<T>::at - index is out of range.");
+
+    return (*this)[pos];
+}
+
+template<typename T, std::size_t BlockShift, typename Allocator>
+typename segmented_vector<T, BlockShift, Allocator>::const_reference segmented_vector<T, BlockShift, Allocator>::at( size_type pos ) const
+{
+    if (!(pos < size()))
+        throw std::out_of_range("segmented_vector<T>::at - index is out of range.");
+
+    return (*this)[pos];
+}
+
+template<typename T, std::size_t BlockShift, typename Allocator>
+void segmented_vector<T, BlockShift, Allocator>::reserve( size_type new_capacity )
+{
+    // Allocate new blocks, existing blocks are never moved, only
+    // the block table can be reallocated (it is small, it has
+    // only one pointer per block).
+    while (capacity() < new_capacity)
+    {
+        pointer block = std::allocator_traits<allocator_type>::allocate(m_allocator, block_size);
+
+        try
+        {
+            m_blocks.push_back(block);
+        }
+        catch (...)
+        {
+            std::allocator_traits<allocator_type>::deallocate(m_allocator, block, block_size);
+            throw;
+        }
+    }
+}
+
+template<typename T, std::size_t BlockShift, typename Allocator>
+void segmented_vector<T, BlockShift, Allocator>::shrink_to_fit()
+{
+    // Release blocks, which do not contain any item
+    const size_type usedBlocks = (m_size + block_mask) >> BlockShift;
+
+    while (m_blocks.size() > usedBlocks)
+    {
+        std::allocator_traits<allocator_type>::deallocate(m_allocator, m_blocks.back(), block_size);
+        m_blocks.pop_back();
+    }
+
+    m_blocks.shrink_to_fit();
+}
+
+template<typename T, std::size_t BlockShift, typename Allocator>
+void segmented_vector<T, BlockShift, Allocator>::resize( size_type count, const value_type& value )
+{
+    while (size() > count)
+    {
+        pop_back();
+    }
+
+    if (count > size())
+    {
+        reserve(count);
+
+        while (size() < count)
+        {
+            emplace_back(value);
+        }
+    }
+}
+
+template<typename T, std::size_t BlockShift, typename Allocator>
+void segmented_vector<T, BlockShift, Allocator>::clear()
+{
+    // Do not release the blocks, so the behaviour is the same as for vector
+    if constexpr (!std::is_trivially_destructible_v<T>)
+    {
+        for (size_type i = 0; i < m_size; ++i)
+        {
+            std::allocator_traits<allocator_type>::destroy(m_allocator, std::addressof((*this)[i]));
+        }
+    }
+
+    m_size = 0;
+}
+
+template<typename T, std::size_t BlockShift, typename Allocator>
+void segmented_vector<T, BlockShift, Allocator>::pop_back()
+{
+    std::allocator_traits<allocator_type>::destroy(m_allocator, std::addressof(back()));
+    --m_size;
+}
+
+template<typename T, std::size_t BlockShift, typename Allocator>
+void segmented_vector<T, BlockShift, Allocator>::swap( segmented_vector& other )
+{
+    m_blocks.swap(other.m_blocks);
+    std::swap(m_size, other.m_size);
+
+    if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value)
+    {
+        std::swap(m_allocator, other.m_allocator);
+    }
+}
+
+template<typename T, std::size_t BlockShift, typename Allocator>
+template<typename... Args>
+typename segmented_vector<T, BlockShift, Allocator>::reference segmented_vector<T, BlockShift, Allocator>::emplace_back( Args&&... args )
+{
+    // If the last block is full, allocate a new one
+    if (m_size == capacity())
+    {
+        reserve(m_size + 1);
+    }
+
+    pointer item = m_blocks[m_size >> BlockShift] + (m_size & block_mask);
+    std::allocator_traits<allocator_type>::construct(m_allocator, item, std::forward<Args>(args)...);
+    ++m_size;
+
+    return *item;
+}
+
+}   // namespace course_l01
+
+#endif // CUSTOM_SEGMENTED_VECTOR_H
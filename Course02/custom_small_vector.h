@@ -0,0 +1,605 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#ifndef CUSTOM_SMALL_VECTOR_H
+#define CUSTOM_SMALL_VECTOR_H
+
+#include "custom_vector.h"
+
+namespace course_l01
+{
+
+// Vector, which stores up to N items inline (inside the object itself),
+// so no memory is allocated for small vectors. If more than N items
+// are stored, items are moved into the memory allocated by the allocator,
+// and small vector then behaves as an ordinary vector.
+template<typename T, std::size_t N, typename Allocator = std::allocator<T>>
+class small_vector
+{
+public:
+    // Type declarations
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = typename std::allocator_traits<allocator_type>::size_type;
+    using difference_type = typename std::allocator_traits<allocator_type>::difference_type;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static_assert(N > 0, "Small vector must have space for at least one inline item.");
+
+    small_vector() noexcept { }
+    explicit small_vector( const Allocator& alloc ) noexcept : m_allocator(alloc) { }
+    explicit small_vector( size_type count, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { resize(count); }
+    template< class InputIt >
+    small_vector( InputIt first, InputIt last, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { insert(end(), first, last); }
+    small_vector( const small_vector& other );
+    small_vector( small_vector&& other ) noexcept(std::is_nothrow_move_constructible_v<T>) : m_allocator(other.m_allocator) { take_items(other); }
+    small_vector( std::initializer_list<T> init, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { insert(end(), init.begin(), init.end()); }
+    ~small_vector();
+
+    // Assignment operator
+    small_vector& operator=( const small_vector& other );
+    small_vector& operator=( small_vector&& other );
+
+    // Assign methods
+    void assign( size_type count, const T& value ) { clear(); insert(end(), count, value); }
+    template< class InputIt, std::enable_if_t<std::is_same_v<T, typename std::iterator_traits<InputIt>::value_type>, int> = 0 >
+    void assign( InputIt first, InputIt last ) { clear(); insert(end(), first, last); }
+    void assign( std::initializer_list<T> ilist ) { clear(); insert(end(), ilist.begin(), ilist.end()); }
+
+    // Element access
+    reference at( size_type pos );
+    const_reference at( size_type pos ) const;
+
+    reference operator[]( size_type pos ) { return m_data[pos]; }
+    const_reference operator[]( size_type pos ) const { return m_data[pos]; }
+
+    reference front() noexcept { return m_data[0]; }
+    const_reference front() const noexcept { return m_data[0]; }
+
+    reference back() noexcept { return m_data[size() - 1]; }
+    const_reference back() const noexcept { return m_data[size() - 1]; }
+
+    pointer data() noexcept { return m_data; }
+    const_pointer data() const noexcept { return m_data; }
+
+    // Iterators
+
+    iterator begin() noexcept { return m_data; }
+    const_iterator begin() const noexcept { return m_data; }
+    const_iterator cbegin() const noexcept { return m_data; }
+
+    iterator end() noexcept { return m_data + m_size; }
+    const_iterator end() const noexcept { return m_data + m_size; }
+    const_iterator cend() const noexcept { return m_data + m_size; }
+
+    reverse_iterator rbegin() noexcept { return std::make_reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return std::make_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return std::make_reverse_iterator(cend()); }
+
+    reverse_iterator rend() noexcept { return std::make_reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return std::make_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return std::make_reverse_iterator(cbegin()); }
+
+    // Capacity methods
+    bool empty() const noexcept { return m_size == 0; }
+    size_type size() const noexcept { return m_size; }
+    size_type max_size() const noexcept { return std::allocator_traits<allocator_type>::max_size(m_allocator); }
+    void reserve( size_type new_capacity ) { grow(new_capacity); }
+    size_type capacity() const noexcept { return m_capacity; }
+    void shrink_to_fit() { shrink(); }
+    void resize( size_type count );
+    void resize( size_type count, const value_type& value );
+
+    // Returns true, if items are stored inline (no memory is allocated)
+    bool is_inline() const noexcept { return m_data == inline_data(); }
+    static constexpr size_type inline_capacity() noexcept { return N; }
+
+    // Modifiers
+    void clear() { erase(begin(), end()); }
+    void push_back( const T& item ) { emplace_back(item); }
+    void push_back( T&& item ) { emplace_back(std::move(item)); }
+    void swap( small_vector& other );
+    void pop_back() { erase(std::prev(end())); }
+
+    // Insert
+    iterator insert( const_iterator pos, const T& value ) { return emplace(pos, value); }
+    iterator insert( const_iterator pos, T&& value ) { return emplace(pos, std::move(value)); }
+    iterator insert( const_iterator pos, size_type count, const T& value );
+    template<class InputIt, std::enable_if_t<std::is_same_v<T, typename std::iterator_traits<InputIt>::value_type>, int> = 0>
+    iterator insert( const_iterator pos, InputIt first, InputIt last );
+    iterator insert( const_iterator pos, std::initializer_list<T> ilist ) { return insert(pos, ilist.begin(), ilist.end()); }
+
+    // Erase
+    iterator erase( iterator pos ) { return erase_impl(pos, 1); }
+    iterator erase( const_iterator pos ) { return erase_impl(pos, 1); }
+    iterator erase( iterator first, iterator last ) { return erase_impl(first, std::distance(first, last)); }
+    iterator erase( const_iterator first, const_iterator last ) { return erase_impl(first, std::distance(first, last)); }
+
+    // Remove
+    size_type remove( const T& value ) { return remove_if([&value](const T& v) { return v == value; }); }
+    template<typename UnaryPredicate>
+    size_type remove_if( UnaryPredicate p );
+
+    // Emplace
+    template<typename... Args>
+    reference emplace_back( Args&&... args );
+    template< class... Args >
+    iterator emplace( const_iterator pos, Args&&... args );
+
+    allocator_type get_allocator() const { return m_allocator; }
+
+private:
+    pointer inline_data() noexcept { return reinterpret_cast<pointer>(m_buffer); }
+    const_pointer inline_data() const noexcept { return reinterpret_cast<const_pointer>(m_buffer); }
+
+    iterator erase_impl( const_iterator pos, size_type count );
+    template<typename Constructor>
+    iterator insert_impl( const_iterator pos, size_type count, Constructor construct_item );
+    void open_gap( size_type index, size_type count );
+    void close_gap( size_type index, size_type count );
+    void destroy_range( pointer first, pointer last );
+    void grow( size_type newSize );
+    void shrink();
+    void reallocate( size_type newCapacity );
+    void relocate( pointer destination, pointer source, size_type count );
+    void take_items( small_vector& other );
+
+    allocator_type m_allocator;
+    pointer m_data = inline_data();
+    size_type m_size = 0;
+    size_type m_capacity = N;
+    alignas(T) unsigned char m_buffer[N * sizeof(T)];
+};
+
+template<typename T, std::size_t N, typename Allocator>
+small_vector<T, N, Allocator>::small_vector( const small_vector& other ) :
+    m_allocator(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.m_allocator))
+{
+    insert(end(), other.begin(), other.end());
+}
+
+template<typename T, std::size_t N, typename Allocator>
+small_vector<T, N, Allocator>::~small_vector()
+{
+    clear();
+    shrink();
+}
+
+template<typename T, std::size_t N, typename Allocator>
+small_vector<T, N, Allocator>& small_vector<T, N, Allocator>::operator=( const small_vector& other )
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value)
+    {
+        // Memory must be released by the allocator which allocated it
+        shrink();
+        m_allocator = other.m_allocator;
+    }
+
+    insert(end(), other.begin(), other.end());
+    return *this;
+}
+
+template<typename T, std::size_t N, typename Allocator>
+small_vector<T, N, Allocator>& small_vector<T, N, Allocator>::operator=( small_vector&& other )
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+    shrink();
+
+    if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value)
+    {
+        m_allocator = other.m_allocator;
+    }
+
+    take_items(other);
+    return *this;
+}
+
+template<typename T, std::size_t N, typename Allocator>
+void small_vector<T, N, Allocator>::take_items( small_vector& other )
+{
+    // This vector must be empty and must not have allocated memory.
+    if (!other.is_inline() && m_allocator == other.m_allocator)
+    {
+        // Other vector has allocated memory, which we can release,
+        // so we just take it and leave the other vector empty.
+        m_data = std::exchange(other.m_data, other.inline_data());
+        m_size = std::exchange(other.m_size, 0);
+        m_capacity = std::exchange(other.m_capacity, N);
+    }
+    else
+    {
+        // Items are stored inline (or in the memory, which we can't
+        // release), so we must move them one by one.
+        insert(end(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        other.clear();
+    }
+}
+
+template<typename T, std::size_t N, typename Allocator>
+typename small_vector<T, N, Allocator>::reference small_vector<T, N, Allocator>::at( size_type pos )
+{
+    if (!(pos < size()))
+        throw std::out_of_range("small_vector<T>::at - index is out of range.");
+
+    return m_data[pos];
+}
+
+template<typename T, std::size_t N, typename Allocator>
+typename small_vector<T, N, Allocator>::const_reference small_vector<T, N, Allocator>::at( size_type pos ) const
+{
+    if (!(pos < size()))
+        throw std::out_of_range("small_vector<T>::at - index is out of range.");
+
+    return m_data[pos];
+}
+
+template<typename T, std::size_t N, typename Allocator>
+void small_vector<T, N, Allocator>::resize( size_type count )
+{
+    if (count < size())
+    {
+        erase(std::prev(end(), size() - count), end());
+    }
+    else if (count > size())
+    {
+        // Value-initialize new items in place, see vector::resize
+        insert_impl(cend(), count - size(), [this](pointer item)
+        {
+            std::allocator_traits<allocator_type>::construct(m_allocator, item);
+        });
+    }
+}
+
+template<typename T, std::size_t N, typename Allocator>
+void small_vector<T, N, Allocator>::resize( size_type count, const value_type& value )
+{
+    if (count < size())
+    {
+        erase(std::prev(end(), size() - count), end());
+    }
+    else if (count > size())
+    {
+        insert(end(), count - size(), value);
+    }
+}
+
+template<typename T, std::size_t N, typename Allocator>
+void small_vector<T, N, Allocator>::swap( small_vector& other )
+{
+    if (!is_inline() && !other.is_inline())
+    {
+        // Both vectors have allocated memory, just swap it
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+
+        if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value)
+        {
+            std::swap(m_allocator, other.m_allocator);
+        }
+    }
+    else
+    {
+        // At least one vector stores its items inline,
+        // so we must move the items through temporary vector.
+        small_vector temporary(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temporary);
+    }
+}
+
+template<typename T, std::size_t N, typename Allocator>
+typename small_vector<T, N, Allocator>::iterator small_vector<T, N, Allocator>::insert( const_iterator pos, size_type count, const T& value )
+{
+    // If we are not inserting anything, just return current iterator
+    if (count == 0)
+        return const_cast<iterator>(pos);
+
+    // Value can be an element of this vector, which
+    // can be moved or reallocated, so we make a copy.
+    value_type copy(value);
+
+    return insert_impl(pos, count, [this, &copy](pointer item)
+    {
+        std::allocator_traits<allocator_type>::construct(m_allocator, item, copy);
+    });
+}
+
+template<typename T, std::size_t N, typename Allocator>
+template<class InputIt, std::enable_if_t<std::is_same_v<T, typename std::iterator_traits<InputIt>::value_type>, int>>
+typename small_vector<T, N, Allocator>::iterator small_vector<T, N, Allocator>::insert( const_iterator pos, InputIt first, InputIt last )
+{
+    // If we are not inserting anything, just return current iterator
+    if (first == last)
+        return const_cast<iterator>(pos);
+
+    using iterator_category = typename std::iterator_traits<InputIt>::iterator_category;
+
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, iterator_category>)
+    {
+        auto count = static_cast<size_type>(std::distance(first, last));
+
+        return insert_impl(pos, count, [this, &first](pointer item)
+        {
+            std::allocator_traits<allocator_type>::construct(m_allocator, item, *first);
+            ++first;
+        });
+    }
+    else
+    {
+        // Single-pass iterator, see vector::insert
+        auto distance = std::distance(cbegin(), pos);
+
+        if (pos == cend())
+        {
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+        else
+        {
+            small_vector temporary(first, last, m_allocator);
+            insert(pos, std::make_move_iterator(temporary.begin()), std::make_move_iterator(temporary.end()));
+        }
+
+        return std::next(begin(), distance);
+    }
+}
+
+template<typename T, std::size_t N, typename Allocator>
+template<typename UnaryPredicate>
+typename small_vector<T, N, Allocator>::size_type small_vector<T, N, Allocator>::remove_if( UnaryPredicate p )
+{
+    auto it = std::remove_if(begin(), end(), p);
+    auto removedItems = static_cast<size_type>(std::distance(it, end()));
+    erase(it, end());
+    return removedItems;
+}
+
+template<typename T, std::size_t N, typename Allocator>
+template<typename... Args>
+typename small_vector<T, N, Allocator>::reference small_vector<T, N, Allocator>::emplace_back( Args&&... args )
+{
+    // Ensure the array is large enough. After
+    // the call, capacity() >= size() + 1.
+    grow(size() + 1);
+
+    // Construct item at given position
+    std::allocator_traits<allocator_type>::construct(m_allocator, data() + size(), std::forward<Args>(args)...);
+
+    // Increment size of the vector
+    ++m_size;
+
+    return back();
+}
+
+template<typename T, std::size_t N, typename Allocator>
+template<typename... Args>
+typename small_vector<T, N, Allocator>::iterator small_vector<T, N, Allocator>::emplace( const_iterator pos, Args&&... args )
+{
+    if (pos == cend())
+    {
+        emplace_back(std::forward<Args>(args)...);
+        return std::prev(end());
+    }
+
+    // Arguments can refer to elements of this vector, which
+    // will be moved, so we construct the new item first.
+    value_type value(std::forward<Args>(args)...);
+
+    return insert_impl(pos, 1, [this, &value](pointer item)
+    {
+        std::allocator_traits<allocator_type>::construct(m_allocator, item, std::move(value));
+    });
+}
+
+template<typename T, std::size_t N, typename Allocator>
+typename small_vector<T, N, Allocator>::iterator small_vector<T, N, Allocator>::erase_impl( const_iterator pos, size_type count )
+{
+    // Do we remove something?
+    if (count == 0)
+        return const_cast<iterator>(pos);
+
+    // Move the tail of the vector over the erased items
+    // in one pass, then destroy the moved-from items at the end.
+    auto itFirst = std::next(begin(), std::distance(cbegin(), pos));
+    auto itLast = std::next(itFirst, count);
+    auto it = std::move(itLast, end(), itFirst);
+
+    destroy_range(it, end());
+
+    // Set new size of the vector
+    m_size -= count;
+
+    return itFirst;
+}
+
+template<typename T, std::size_t N, typename Allocator>
+template<typename Constructor>
+typename small_vector<T, N, Allocator>::iterator small_vector<T, N, Allocator>::insert_impl( const_iterator pos, size_type count, Constructor construct_item )
+{
+    auto index = static_cast<size_type>(std::distance(cbegin(), pos));
+
+    grow(size() + count);
+    open_gap(index, count);
+
+    size_type constructed = 0;
+
+    try
+    {
+        for (; constructed < count; ++constructed)
+        {
+            construct_item(data() + index + constructed);
+        }
+    }
+    catch (...)
+    {
+        destroy_range(data() + index, data() + index + constructed);
+        close_gap(index, count);
+        throw;
+    }
+
+    m_size += count;
+    return std::next(begin(), index);
+}
+
+template<typename T, std::size_t N, typename Allocator>
+void small_vector<T, N, Allocator>::open_gap( size_type index, size_type count )
+{
+    // Move items [index, size()) to [index + count, size() + count),
+    // see vector::open_gap.
+    pointer source = data() + index;
+    pointer destination = source + count;
+    const size_type tailSize = size() - index;
+
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        if (tailSize > 0)
+            std::memmove(static_cast<void*>(destination), static_cast<const void*>(source), tailSize * sizeof(T));
+    }
+    else
+    {
+        for (size_type i = tailSize; i > 0; --i)
+        {
+            std::allocator_traits<allocator_type>::construct(m_allocator, destination + i - 1, std::move(source[i - 1]));
+            std::allocator_traits<allocator_type>::destroy(m_allocator, source + i - 1);
+        }
+    }
+}
+
+template<typename T, std::size_t N, typename Allocator>
+void small_vector<T, N, Allocator>::close_gap( size_type index, size_type count )
+{
+    // Reverse operation to open_gap
+    pointer destination = data() + index;
+    pointer source = destination + count;
+    const size_type tailSize = size() - index;
+
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        if (tailSize > 0)
+            std::memmove(static_cast<void*>(destination), static_cast<const void*>(source), tailSize * sizeof(T));
+    }
+    else
+    {
+        for (size_type i = 0; i < tailSize; ++i)
+        {
+            std::allocator_traits<allocator_type>::construct(m_allocator, destination + i, std::move(source[i]));
+            std::allocator_traits<allocator_type>::destroy(m_allocator, source + i);
+        }
+    }
+}
+
+template<typename T, std::size_t N, typename Allocator>
+void small_vector<T, N, Allocator>::destroy_range( pointer first, pointer last )
+{
+    if constexpr (!std::is_trivially_destructible_v<T>)
+    {
+        for (; first != last; ++first)
+            std::allocator_traits<allocator_type>::destroy(m_allocator, first);
+    }
+}
+
+template<typename T, std::size_t N, typename Allocator>
+void small_vector<T, N, Allocator>::grow( size_type newSize )
+{
+    // If we have enough space (inline or allocated), do nothing
+    if (newSize <= capacity())
+        return;
+
+    // If we want to allocate too much items, throw exception
+    if (newSize > max_size())
+        throw std::bad_alloc();
+
+    size_type newCapacity = capacity();
+
+    while (newCapacity < newSize)
+        newCapacity = 2 * newCapacity;
+
+    reallocate(newCapacity);
+}
+
+template<typename T, std::size_t N, typename Allocator>
+void small_vector<T, N, Allocator>::shrink()
+{
+    // Inline storage can't be shrinked
+    if (is_inline() || capacity() == size())
+        return;
+
+    // If items fit into inline storage, move them back
+    // and release the allocated memory.
+    reallocate(size() <= N ? N : size());
+}
+
+template<typename T, std::size_t N, typename Allocator>
+void small_vector<T, N, Allocator>::reallocate( size_type newCapacity )
+{
+    // Allocate new memory (or use inline storage, if the capacity
+    // is small enough) and move all items into it.
+    pointer data = (newCapacity <= N) ? inline_data() : std::allocator_traits<allocator_type>::allocate(m_allocator, newCapacity);
+
+    relocate(data, m_data, size());
+
+    if (!is_inline())
+    {
+        std::allocator_traits<allocator_type>::deallocate(m_allocator, m_data, m_capacity);
+    }
+
+    // Set new data. Size is not changed, only capacity.
+    m_data = data;
+    m_capacity = (newCapacity <= N) ? N : newCapacity;
+}
+
+template<typename T, std::size_t N, typename Allocator>
+void small_vector<T, N, Allocator>::relocate( pointer destination, pointer source, size_type count )
+{
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        if (count > 0)
+            std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+    }
+    else
+    {
+        for (size_type i = 0; i < count; ++i)
+        {
+            std::allocator_traits<allocator_type>::construct(m_allocator, destination + i, std::move(source[i]));
+            std::allocator_traits<allocator_type>::destroy(m_allocator, source + i);
+        }
+    }
+}
+
+}   // namespace course_l01
+
+#endif // CUSTOM_SMALL_VECTOR_H
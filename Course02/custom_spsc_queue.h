@@ -0,0 +1,284 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#ifndef CUSTOM_SPSC_QUEUE_H
+#define CUSTOM_SPSC_QUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <algorithm>
+
+#include "custom_aligned.h"
+
+namespace course_l01
+{
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Items are stored in a circular buffer of power-of-two capacity.
+// Producer owns the tail index, consumer owns the head index, each index
+// is published by a release store and read by an acquire load, and each
+// lives on its own cache line together with the owner's cached copy
+// of the other index, so indices are shared only when the cached copy
+// says the queue is full (producer) or empty (consumer).
+//
+// push, try_push, try_push_n and emplace may be called only by the producer,
+// front, pop, try_pop and try_pop_n only by the consumer.
+template<typename T, typename Allocator = std::allocator<T>>
+class spsc_queue
+{
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = typename std::allocator_traits<allocator_type>::size_type;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename std::allocator_traits<allocator_type>::pointer;
+
+    // Capacity is rounded up to a power of two
+    explicit spsc_queue( size_type capacity, const Allocator& alloc = Allocator() );
+    spsc_queue( const spsc_queue& ) = delete;
+    spsc_queue& operator=( const spsc_queue& ) = delete;
+    ~spsc_queue();
+
+    // Size is exact only if neither thread is modifying the queue
+    bool empty() const noexcept { return m_head.load(std::memory_order_relaxed) == m_tail.load(std::memory_order_acquire); }
+    size_type size() const noexcept;
+    size_type capacity() const noexcept { return m_capacity; }
+
+    // Producer, try_ functions return false when the queue is full,
+    // other functions wait until there is a free slot.
+    bool try_push( const value_type& value ) { return try_emplace(value); }
+    bool try_push( value_type&& value ) { return try_emplace(std::move(value)); }
+    template<typename... Args>
+    bool try_emplace( Args&&... args );
+
+    void push( const value_type& value ) { emplace(value); }
+    void push( value_type&& value ) { emplace(std::move(value)); }
+    template<typename... Args>
+    void emplace( Args&&... args );
+
+    // Pushes up to count items and publishes them at once,
+    // returns number of items pushed.
+    template<typename InputIt>
+    size_type try_push_n( InputIt first, size_type count );
+
+    // Consumer, front and pop require the queue not to be empty
+    reference front() noexcept { return m_data[m_head.load(std::memory_order_relaxed) & m_mask]; }
+    void pop() noexcept;
+    bool try_pop( value_type& value );
+
+    // Moves up to count items to the output and releases their
+    // slots at once, returns number of items popped.
+    template<typename OutputIt>
+    size_type try_pop_n( OutputIt out, size_type count );
+
+private:
+    size_type free_slots( size_type tail, size_type wanted ) noexcept;
+    size_type ready_items( size_type head, size_type wanted ) noexcept;
+
+    // Shared read-only data
+    allocator_type m_allocator;
+    pointer m_data = nullptr;
+    size_type m_capacity = 0;
+    size_type m_mask = 0;
+
+    // Indices grow without wrapping, they are masked on access.
+    // Producer's cache line.
+    alignas(cache_line_size) std::atomic<size_type> m_tail = 0;
+    size_type m_cachedHead = 0;
+
+    // Consumer's cache line
+    alignas(cache_line_size) std::atomic<size_type> m_head = 0;
+    size_type m_cachedTail = 0;
+};
+
+template<typename T, typename Allocator>
+spsc_queue<T, Allocator>::spsc_queue( size_type capacity, const Allocator& alloc ) :
+    m_allocator(alloc)
+{
+    m_capacity = 1;
+    while (m_capacity < capacity)
+    {
+        m_capacity *= 2;
+    }
+
+    m_mask = m_capacity - 1;
+    m_data = std::allocator_traits<allocator_type>::allocate(m_allocator, m_capacity);
+}
+
+template<typename T, typename Allocator>
+spsc_queue<T, Allocator>::~spsc_queue()
+{
+    const size_type tail = m_tail.load(std::memory_order_acquire);
+    for (size_type head = m_head.load(std::memory_order_relaxed); head != tail; ++head)
+    {
+        std::allocator_traits<allocator_type>::destroy(m_allocator, m_data + (head & m_mask));
+    }
+
+    std::allocator_traits<allocator_type>::deallocate(m_allocator, m_data, m_capacity);
+}
+
+template<typename T, typename Allocator>
+typename spsc_queue<T, Allocator>::size_type spsc_queue<T, Allocator>::size() const noexcept
+{
+    // Head is loaded first, the tail loaded later can't be behind it,
+    // so the difference never underflows when the consumer advances.
+    // Producer can advance meanwhile too, so the size is clamped.
+    const size_type head = m_head.load(std::memory_order_acquire);
+    const size_type tail = m_tail.load(std::memory_order_acquire);
+    return std::min(tail - head, m_capacity);
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+bool spsc_queue<T, Allocator>::try_emplace( Args&&... args )
+{
+    const size_type tail = m_tail.load(std::memory_order_relaxed);
+
+    if (free_slots(tail, 1) == 0)
+        return false;
+
+    std::allocator_traits<allocator_type>::construct(m_allocator, m_data + (tail & m_mask), std::forward<Args>(args)...);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+void spsc_queue<T, Allocator>::emplace( Args&&... args )
+{
+    const size_type tail = m_tail.load(std::memory_order_relaxed);
+
+    while (free_slots(tail, 1) == 0)
+    {
+        std::this_thread::yield();
+    }
+
+    std::allocator_traits<allocator_type>::construct(m_allocator, m_data + (tail & m_mask), std::forward<Args>(args)...);
+    m_tail.store(tail + 1, std::memory_order_release);
+}
+
+template<typename T, typename Allocator>
+template<typename InputIt>
+typename spsc_queue<T, Allocator>::size_type spsc_queue<T, Allocator>::try_push_n( InputIt first, size_type count )
+{
+    const size_type tail = m_tail.load(std::memory_order_relaxed);
+    const size_type pushCount = std::min(count, free_slots(tail, count));
+    size_type i = 0;
+
+    try
+    {
+        for (; i < pushCount; ++i, ++first)
+        {
+            std::allocator_traits<allocator_type>::construct(m_allocator, m_data + ((tail + i) & m_mask), *first);
+        }
+    }
+    catch (...)
+    {
+        // Publish the items constructed before the exception
+        m_tail.store(tail + i, std::memory_order_release);
+        throw;
+    }
+
+    m_tail.store(tail + pushCount, std::memory_order_release);
+    return pushCount;
+}
+
+template<typename T, typename Allocator>
+void spsc_queue<T, Allocator>::pop() noexcept
+{
+    const size_type head = m_head.load(std::memory_order_relaxed);
+    std::allocator_traits<allocator_type>::destroy(m_allocator, m_data + (head & m_mask));
+    m_head.store(head + 1, std::memory_order_release);
+}
+
+template<typename T, typename Allocator>
+bool spsc_queue<T, Allocator>::try_pop( value_type& value )
+{
+    const size_type head = m_head.load(std::memory_order_relaxed);
+
+    if (ready_items(head, 1) == 0)
+        return false;
+
+    pointer item = m_data + (head & m_mask);
+    value = std::move(*item);
+    std::allocator_traits<allocator_type>::destroy(m_allocator, item);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, typename Allocator>
+template<typename OutputIt>
+typename spsc_queue<T, Allocator>::size_type spsc_queue<T, Allocator>::try_pop_n( OutputIt out, size_type count )
+{
+    const size_type head = m_head.load(std::memory_order_relaxed);
+    const size_type popCount = std::min(count, ready_items(head, count));
+    size_type i = 0;
+
+    try
+    {
+        for (; i < popCount; ++i, ++out)
+        {
+            pointer item = m_data + ((head + i) & m_mask);
+            *out = std::move(*item);
+            std::allocator_traits<allocator_type>::destroy(m_allocator, item);
+        }
+    }
+    catch (...)
+    {
+        // Release the slots of the items popped before the exception
+        m_head.store(head + i, std::memory_order_release);
+        throw;
+    }
+
+    m_head.store(head + popCount, std::memory_order_release);
+    return popCount;
+}
+
+template<typename T, typename Allocator>
+typename spsc_queue<T, Allocator>::size_type spsc_queue<T, Allocator>::free_slots( size_type tail, size_type wanted ) noexcept
+{
+    // Head is loaded from the consumer's cache line only, when
+    // the cached value says there are not enough free slots.
+    if (m_capacity - (tail - m_cachedHead) < wanted)
+    {
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+    }
+
+    return m_capacity - (tail - m_cachedHead);
+}
+
+template<typename T, typename Allocator>
+typename spsc_queue<T, Allocator>::size_type spsc_queue<T, Allocator>::ready_items( size_type head, size_type wanted ) noexcept
+{
+    // Cached tail may be behind the head, if items were
+    // consumed by front and pop, which don't use the cache.
+    if (m_cachedTail < head + wanted)
+    {
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+    }
+
+    return m_cachedTail - head;
+}
+
+}   // namespace course_l01
+
+#endif // CUSTOM_SPSC_QUEUE_H
@@ -20,12 +20,20 @@
 #ifndef CUSTOM_STACK_H
 #define CUSTOM_STACK_H
 
-#include "custom_list.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <cstdint>
+#include <functional>
+
+#include "custom_ring_buffer.h"
+#include "custom_aligned.h"
 
 namespace course_l01
 {
 
-template<typename T, class Container = list<T>>
+template<typename T, class Container = ring_buffer<T>>
 class stack
 {
 public:
@@ -58,6 +66,341 @@ private:
     container_type m_container;
 };
 
+// Lock-free stack for many threads (Treiber stack). Items are stored in
+// nodes, which are addressed by 32-bit indices, the head of the stack
+// is a 64-bit word holding the index of the top node and a tag, which
+// changes on every push and pop. So compare-exchange of the head fails,
+// if the head was changed meanwhile, even if the same node is on the top
+// again (ABA problem). Nodes are never released while the stack exists,
+// popped nodes are reused through an internal free list (which is also
+// a tagged stack), so a thread reading a node just popped by other thread
+// doesn't read freed memory.
+//
+// When compare-exchange of the head fails because of contention, the thread
+// tries to meet a thread doing the opposite operation in an elimination
+// array, where a push hands its node directly to a pop, so both complete
+// without touching the head.
+template<typename T, typename Allocator = std::allocator<T>>
+class lockfree_stack
+{
+private:
+    struct _node;
+    using node_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<_node>;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+
+    lockfree_stack() = default;
+    explicit lockfree_stack( const Allocator& alloc ) : m_allocator(alloc) { }
+    lockfree_stack( const lockfree_stack& ) = delete;
+    lockfree_stack& operator=( const lockfree_stack& ) = delete;
+    ~lockfree_stack();
+
+    // Result is exact only if no thread is modifying the stack
+    bool empty() const noexcept { return index_of(m_head.load(std::memory_order_acquire)) == null_index; }
+
+    void push( const value_type& value ) { emplace(value); }
+    void push( value_type&& value ) { emplace(std::move(value)); }
+    template<typename... Args>
+    void emplace( Args&&... args );
+
+    // Pops the top item into value, returns false, if the stack is empty
+    bool try_pop( value_type& value );
+
+private:
+    using index_type = std::uint32_t;
+    using word_type = std::uint64_t;
+
+    static constexpr index_type null_index = index_type(-1);
+    static constexpr size_type first_chunk_size = 64;
+    static constexpr size_type max_chunk_count = 26;
+    static constexpr size_type elimination_slot_count = 8;
+    static constexpr int elimination_spin_count = 128;
+
+    struct _node
+    {
+        std::atomic<index_type> next;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    // Slot holds the index of the node offered by a push (plus one, zero
+    // is empty slot) and a version, which changes on every transition.
+    struct alignas(cache_line_size) _elimination_slot
+    {
+        std::atomic<word_type> state{ 0 };
+    };
+
+    static word_type make_word( index_type index, word_type tag ) noexcept { return (tag << 32) | index; }
+    static index_type index_of( word_type word ) noexcept { return index_type(word); }
+    static word_type tag_of( word_type word ) noexcept { return word >> 32; }
+
+    _node* node_at( index_type index ) const noexcept;
+
+    // Operations of the tagged stacks (items and free nodes)
+    bool try_push_node( std::atomic<word_type>& head, index_type index, index_type last ) noexcept;
+    enum class pop_result { popped, empty, contention };
+    pop_result try_pop_node( std::atomic<word_type>& head, index_type& index ) noexcept;
+
+    index_type allocate_node();
+    void free_node( index_type index ) noexcept;
+    void grow();
+
+    bool eliminate_push( index_type index ) noexcept;
+    bool eliminate_pop( index_type& index ) noexcept;
+    static _elimination_slot& random_slot( _elimination_slot* slots ) noexcept;
+
+    node_allocator_type m_allocator;
+    std::atomic<_node*> m_chunks[max_chunk_count] = { };
+    size_type m_chunkCount = 0;
+    std::mutex m_growMutex;
+
+    alignas(cache_line_size) std::atomic<word_type> m_head{ make_word(null_index, 0) };
+    alignas(cache_line_size) std::atomic<word_type> m_freeHead{ make_word(null_index, 0) };
+    _elimination_slot m_elimination[elimination_slot_count];
+};
+
+template<typename T, typename Allocator>
+lockfree_stack<T, Allocator>::~lockfree_stack()
+{
+    // Single thread is left, destroy items and release the chunks
+    for (index_type index = index_of(m_head.load(std::memory_order_acquire)); index != null_index;)
+    {
+        _node* node = node_at(index);
+        node->value()->~T();
+        index = node->next.load(std::memory_order_relaxed);
+    }
+
+    for (size_type i = 0; i < m_chunkCount; ++i)
+    {
+        std::allocator_traits<node_allocator_type>::deallocate(m_allocator, m_chunks[i].load(std::memory_order_relaxed), first_chunk_size << i);
+    }
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+void lockfree_stack<T, Allocator>::emplace( Args&&... args )
+{
+    const index_type index = allocate_node();
+    _node* node = node_at(index);
+
+    try
+    {
+        ::new (static_cast<void*>(node->storage)) T(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        free_node(index);
+        throw;
+    }
+
+    while (!try_push_node(m_head, index, index) && !eliminate_push(index))
+    {
+    }
+}
+
+template<typename T, typename Allocator>
+bool lockfree_stack<T, Allocator>::try_pop( value_type& value )
+{
+    index_type index = null_index;
+
+    for (;;)
+    {
+        const pop_result result = try_pop_node(m_head, index);
+
+        if (result == pop_result::popped)
+            break;
+
+        if (result == pop_result::empty)
+            return false;
+
+        if (eliminate_pop(index))
+            break;
+    }
+
+    _node* node = node_at(index);
+
+    try
+    {
+        value = std::move(*node->value());
+    }
+    catch (...)
+    {
+        // Return the item back to the stack
+        while (!try_push_node(m_head, index, index))
+        {
+        }
+
+        throw;
+    }
+
+    node->value()->~T();
+    free_node(index);
+    return true;
+}
+
+template<typename T, typename Allocator>
+typename lockfree_stack<T, Allocator>::_node* lockfree_stack<T, Allocator>::node_at( index_type index ) const noexcept
+{
+    // Chunk i has first_chunk_size * 2^i nodes, so the chunk
+    // is given by the highest bit of index / first_chunk_size + 1.
+    const size_type position = size_type(index) / first_chunk_size + 1;
+
+#if defined(__GNUC__) || defined(__clang__)
+    const size_type chunk = size_type(63 - __builtin_clzll(position));
+#else
+    size_type chunk = 0;
+    while ((position >> (chunk + 1)) != 0)
+    {
+        ++chunk;
+    }
+#endif
+
+    const size_type offset = size_type(index) - first_chunk_size * ((size_type(1) << chunk) - 1);
+    return m_chunks[chunk].load(std::memory_order_acquire) + offset;
+}
+
+template<typename T, typename Allocator>
+bool lockfree_stack<T, Allocator>::try_push_node( std::atomic<word_type>& head, index_type index, index_type last ) noexcept
+{
+    // Pushes the chain of nodes from index to last by one attempt
+    word_type oldHead = head.load(std::memory_order_relaxed);
+    node_at(last)->next.store(index_of(oldHead), std::memory_order_relaxed);
+    return head.compare_exchange_weak(oldHead, make_word(index, tag_of(oldHead) + 1), std::memory_order_release, std::memory_order_relaxed);
+}
+
+template<typename T, typename Allocator>
+typename lockfree_stack<T, Allocator>::pop_result lockfree_stack<T, Allocator>::try_pop_node( std::atomic<word_type>& head, index_type& index ) noexcept
+{
+    word_type oldHead = head.load(std::memory_order_acquire);
+    index = index_of(oldHead);
+
+    if (index == null_index)
+        return pop_result::empty;
+
+    // Node may be popped and reused by other thread meanwhile, then
+    // the next index is garbage, but the tag makes the exchange fail.
+    const index_type next = node_at(index)->next.load(std::memory_order_relaxed);
+
+    if (head.compare_exchange_weak(oldHead, make_word(next, tag_of(oldHead) + 1), std::memory_order_acquire, std::memory_order_relaxed))
+        return pop_result::popped;
+
+    return pop_result::contention;
+}
+
+template<typename T, typename Allocator>
+typename lockfree_stack<T, Allocator>::index_type lockfree_stack<T, Allocator>::allocate_node()
+{
+    for (;;)
+    {
+        index_type index = null_index;
+        const pop_result result = try_pop_node(m_freeHead, index);
+
+        if (result == pop_result::popped)
+            return index;
+
+        if (result == pop_result::empty)
+            grow();
+    }
+}
+
+template<typename T, typename Allocator>
+void lockfree_stack<T, Allocator>::free_node( index_type index ) noexcept
+{
+    while (!try_push_node(m_freeHead, index, index))
+    {
+    }
+}
+
+template<typename T, typename Allocator>
+void lockfree_stack<T, Allocator>::grow()
+{
+    // Growing is rare, so it is serialized by a mutex. Other threads
+    // may have filled the free list, while this thread was waiting.
+    std::lock_guard<std::mutex> lock(m_growMutex);
+
+    if (index_of(m_freeHead.load(std::memory_order_acquire)) != null_index)
+        return;
+
+    if (m_chunkCount == max_chunk_count)
+        throw std::bad_alloc();
+
+    const size_type chunkSize = first_chunk_size << m_chunkCount;
+    const size_type firstIndex = first_chunk_size * ((size_type(1) << m_chunkCount) - 1);
+    _node* chunk = std::allocator_traits<node_allocator_type>::allocate(m_allocator, chunkSize);
+
+    for (size_type i = 0; i < chunkSize; ++i)
+    {
+        ::new (static_cast<void*>(chunk + i)) _node();
+        chunk[i].next.store(index_type(firstIndex + i + 1), std::memory_order_relaxed);
+    }
+
+    m_chunks[m_chunkCount].store(chunk, std::memory_order_release);
+    ++m_chunkCount;
+
+    // Whole chunk is pushed to the free list as one chain
+    const index_type first = index_type(firstIndex);
+    const index_type last = index_type(firstIndex + chunkSize - 1);
+    while (!try_push_node(m_freeHead, first, last))
+    {
+    }
+}
+
+template<typename T, typename Allocator>
+bool lockfree_stack<T, Allocator>::eliminate_push( index_type index ) noexcept
+{
+    _elimination_slot& slot = random_slot(m_elimination);
+    word_type state = slot.state.load(std::memory_order_relaxed);
+
+    if (index_of(state) != 0)
+        return false;
+
+    // Offer the node and wait for a pop to take it
+    const word_type offer = make_word(index + 1, tag_of(state) + 1);
+    if (!slot.state.compare_exchange_strong(state, offer, std::memory_order_release, std::memory_order_relaxed))
+        return false;
+
+    for (int i = 0; i < elimination_spin_count; ++i)
+    {
+        if (slot.state.load(std::memory_order_relaxed) != offer)
+            return true;
+    }
+
+    // Withdraw the offer, if it fails, a pop has just taken the node
+    word_type expected = offer;
+    return !slot.state.compare_exchange_strong(expected, make_word(0, tag_of(offer) + 1), std::memory_order_relaxed, std::memory_order_relaxed);
+}
+
+template<typename T, typename Allocator>
+bool lockfree_stack<T, Allocator>::eliminate_pop( index_type& index ) noexcept
+{
+    _elimination_slot& slot = random_slot(m_elimination);
+    word_type state = slot.state.load(std::memory_order_acquire);
+
+    if (index_of(state) == 0)
+        return false;
+
+    if (!slot.state.compare_exchange_strong(state, make_word(0, tag_of(state) + 1), std::memory_order_acquire, std::memory_order_relaxed))
+        return false;
+
+    index = index_of(state) - 1;
+    return true;
+}
+
+template<typename T, typename Allocator>
+typename lockfree_stack<T, Allocator>::_elimination_slot& lockfree_stack<T, Allocator>::random_slot( _elimination_slot* slots ) noexcept
+{
+    // Each thread has its own xorshift generator, seeded by its id
+    thread_local std::uint32_t random = std::uint32_t(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+    return slots[random % elimination_slot_count];
+}
+
 }   // namespace course_l01
 
 #endif // CUSTOM_STACK_H
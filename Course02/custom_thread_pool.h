@@ -0,0 +1,445 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#ifndef CUSTOM_THREAD_POOL_H
+#define CUSTOM_THREAD_POOL_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <utility>
+#include <cstdint>
+#include <type_traits>
+#include <algorithm>
+
+#include "custom_vector.h"
+#include "custom_aligned.h"
+#include "custom_mpmc_queue.h"
+#include "custom_work_stealing_deque.h"
+
+namespace course_l01
+{
+
+class task_group;
+
+// Thread pool with work stealing. Every worker has its own deque, tasks
+// created by a worker are pushed to its deque and the worker takes them
+// back in LIFO order (which keeps the data in its cache), idle workers
+// steal the oldest tasks (usually the largest pieces of work) of other
+// workers. Tasks created outside of the pool are pushed to a shared queue.
+// Workers with nothing to do spin for a while, then they sleep until a new
+// task is scheduled.
+//
+// Tasks are expected to be waited for by a task_group, the pool must
+// not be destroyed while a task group is running its tasks.
+class thread_pool
+{
+public:
+    explicit thread_pool( std::size_t threadCount = std::thread::hardware_concurrency() );
+    thread_pool( const thread_pool& ) = delete;
+    thread_pool& operator=( const thread_pool& ) = delete;
+    ~thread_pool();
+
+    std::size_t thread_count() const noexcept { return m_workers.size(); }
+
+    // Runs the function in the pool, exception thrown
+    // by the function terminates the program.
+    template<typename Function>
+    void submit( Function&& function ) { schedule(make_task(std::forward<Function>(function), nullptr)); }
+
+private:
+    friend class task_group;
+
+    struct _task
+    {
+        explicit _task( task_group* taskGroup ) : group(taskGroup) { }
+        virtual ~_task() = default;
+        virtual void execute() = 0;
+
+        task_group* group = nullptr;
+    };
+
+    template<typename Function>
+    struct _function_task : public _task
+    {
+        _function_task( Function&& taskFunction, task_group* taskGroup ) : _task(taskGroup), function(std::move(taskFunction)) { }
+        _function_task( const Function& taskFunction, task_group* taskGroup ) : _task(taskGroup), function(taskFunction) { }
+
+        void execute() override { function(); }
+
+        Function function;
+    };
+
+    struct alignas(cache_line_size) _worker
+    {
+        explicit _worker( thread_pool* workerPool, std::uint32_t seed ) : pool(workerPool), random(seed) { }
+
+        thread_pool* pool = nullptr;
+        work_stealing_deque<_task*> deque;
+        std::uint32_t random = 1;
+        std::thread thread;
+    };
+
+    template<typename Function>
+    static _task* make_task( Function&& function, task_group* group )
+    {
+        return new _function_task<std::decay_t<Function>>(std::forward<Function>(function), group);
+    }
+
+    void schedule( _task* task );
+    bool execute_one();
+    _task* find_task( _worker* worker ) noexcept;
+    void execute( _task* task );
+    void run_worker( _worker* worker );
+    void stop_workers() noexcept;
+    _worker* current_worker() const noexcept;
+
+    static constexpr int spin_count = 64;
+    static constexpr std::size_t injection_capacity = 4096;
+
+    vector<std::unique_ptr<_worker>> m_workers;
+    mpmc_queue<_task*> m_injection{ injection_capacity };
+
+    // Sleeping workers wait, until the epoch changes
+    alignas(cache_line_size) std::atomic<std::size_t> m_sleeping = 0;
+    std::atomic<std::size_t> m_epoch = 0;
+    std::atomic<bool> m_stop = false;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+
+    static inline thread_local _worker* s_currentWorker = nullptr;
+};
+
+// Group of tasks, which can be waited for (fork/join). Waiting thread
+// doesn't block, it executes tasks of the pool until all tasks of the
+// group are finished, so tasks can create nested groups and wait for
+// them. First exception thrown by a task of the group is rethrown by wait.
+class task_group
+{
+public:
+    explicit task_group( thread_pool& pool ) : m_pool(pool) { }
+    task_group( const task_group& ) = delete;
+    task_group& operator=( const task_group& ) = delete;
+    ~task_group();
+
+    template<typename Function>
+    void run( Function&& function );
+    void wait();
+
+private:
+    friend class thread_pool;
+
+    void finish_task( std::exception_ptr error ) noexcept;
+
+    thread_pool& m_pool;
+    std::atomic<std::size_t> m_pendingTasks = 0;
+    std::atomic<bool> m_errorClaimed = false;
+    std::exception_ptr m_error;
+};
+
+inline thread_pool::thread_pool( std::size_t threadCount )
+{
+    threadCount = std::max<std::size_t>(threadCount, 1);
+    m_workers.reserve(threadCount);
+
+    for (std::size_t i = 0; i < threadCount; ++i)
+    {
+        m_workers.push_back(std::make_unique<_worker>(this, std::uint32_t(2 * i + 1)));
+    }
+
+    // Workers are started, when all deques exist,
+    // because they steal from each other.
+    try
+    {
+        for (std::unique_ptr<_worker>& worker : m_workers)
+        {
+            worker->thread = std::thread(&thread_pool::run_worker, this, worker.get());
+        }
+    }
+    catch (...)
+    {
+        stop_workers();
+        throw;
+    }
+}
+
+inline thread_pool::~thread_pool()
+{
+    stop_workers();
+}
+
+inline void thread_pool::stop_workers() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop.store(true, std::memory_order_release);
+        m_epoch.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    m_wakeUp.notify_all();
+
+    for (std::unique_ptr<_worker>& worker : m_workers)
+    {
+        if (worker->thread.joinable())
+        {
+            worker->thread.join();
+        }
+    }
+}
+
+inline void thread_pool::schedule( _task* task )
+{
+    _worker* worker = current_worker();
+
+    if (worker)
+    {
+        try
+        {
+            worker->deque.push(task);
+        }
+        catch (...)
+        {
+            delete task;
+            throw;
+        }
+    }
+    else
+    {
+        m_injection.push(task);
+    }
+
+    // Pairs with the fence of a worker going to sleep: either the worker
+    // sees the new task, or this thread sees the sleeping worker.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_sleeping.load(std::memory_order_relaxed) > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_epoch.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        m_wakeUp.notify_one();
+    }
+}
+
+inline bool thread_pool::execute_one()
+{
+    _task* task = find_task(current_worker());
+
+    if (!task)
+        return false;
+
+    execute(task);
+    return true;
+}
+
+inline thread_pool::_task* thread_pool::find_task( _worker* worker ) noexcept
+{
+    _task* task = nullptr;
+
+    if (worker && worker->deque.pop(task))
+        return task;
+
+    if (m_injection.try_pop(task))
+        return task;
+
+    // Steal from the workers, starting by a random one
+    std::uint32_t start = 0;
+    if (worker)
+    {
+        worker->random ^= worker->random << 13;
+        worker->random ^= worker->random >> 17;
+        worker->random ^= worker->random << 5;
+        start = worker->random;
+    }
+
+    const std::size_t count = m_workers.size();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        _worker* victim = m_workers[(start + i) % count].get();
+
+        if (victim != worker && victim->deque.steal(task))
+            return task;
+    }
+
+    return nullptr;
+}
+
+inline void thread_pool::execute( _task* task )
+{
+    std::unique_ptr<_task> taskGuard(task);
+    task_group* group = task->group;
+
+    if (!group)
+    {
+        task->execute();
+        return;
+    }
+
+    std::exception_ptr error;
+
+    try
+    {
+        task->execute();
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    // Task is destroyed before the group is told it has finished,
+    // because the group (and data used by the task) may be gone then.
+    taskGuard.reset();
+    group->finish_task(std::move(error));
+}
+
+inline void thread_pool::run_worker( _worker* worker )
+{
+    s_currentWorker = worker;
+
+    for (;;)
+    {
+        if (_task* task = find_task(worker))
+        {
+            execute(task);
+            continue;
+        }
+
+        // Spin for a while, new tasks usually come soon in fork/join
+        bool found = false;
+        for (int i = 0; i < spin_count && !found; ++i)
+        {
+            std::this_thread::yield();
+
+            if (_task* task = find_task(worker))
+            {
+                execute(task);
+                found = true;
+            }
+        }
+
+        if (found)
+            continue;
+
+        // Announce the sleep and look for a task once more,
+        // so a task scheduled meanwhile is not missed.
+        const std::size_t epoch = m_epoch.load(std::memory_order_relaxed);
+        m_sleeping.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (_task* task = find_task(worker))
+        {
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+            execute(task);
+            continue;
+        }
+
+        if (m_stop.load(std::memory_order_acquire))
+        {
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeUp.wait(lock, [this, epoch]() { return m_epoch.load(std::memory_order_relaxed) != epoch; });
+        }
+
+        m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    s_currentWorker = nullptr;
+}
+
+inline thread_pool::_worker* thread_pool::current_worker() const noexcept
+{
+    // Thread may be a worker of other pool
+    _worker* worker = s_currentWorker;
+    return worker && worker->pool == this ? worker : nullptr;
+}
+
+inline task_group::~task_group()
+{
+    // Tasks refer to the group, so they must finish before it is destroyed.
+    // Exception is not rethrown from the destructor.
+    while (m_pendingTasks.load(std::memory_order_acquire) > 0)
+    {
+        if (!m_pool.execute_one())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+template<typename Function>
+void task_group::run( Function&& function )
+{
+    thread_pool::_task* task = thread_pool::make_task(std::forward<Function>(function), this);
+    m_pendingTasks.fetch_add(1, std::memory_order_relaxed);
+
+    try
+    {
+        m_pool.schedule(task);
+    }
+    catch (...)
+    {
+        m_pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+}
+
+inline void task_group::wait()
+{
+    while (m_pendingTasks.load(std::memory_order_acquire) > 0)
+    {
+        if (!m_pool.execute_one())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // Error was stored before the last task was finished
+    if (m_error)
+    {
+        m_errorClaimed.store(false, std::memory_order_relaxed);
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+    }
+}
+
+inline void task_group::finish_task( std::exception_ptr error ) noexcept
+{
+    if (error)
+    {
+        // Only the first exception is kept
+        if (!m_errorClaimed.exchange(true, std::memory_order_relaxed))
+        {
+            m_error = std::move(error);
+        }
+    }
+
+    m_pendingTasks.fetch_sub(1, std::memory_order_release);
+}
+
+}   // namespace course_l01
+
+#endif // CUSTOM_THREAD_POOL_H
@@ -0,0 +1,948 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#ifndef CUSTOM_UNROLLED_LIST_H
+#define CUSTOM_UNROLLED_LIST_H
+
+#include <iterator>
+#include <memory>
+#include <functional>
+#include <utility>
+#include <algorithm>
+
+#include "custom_vector.h"
+
+namespace course_l01
+{
+
+// Unrolled linked list. Each node (block) of the list holds up to BlockSize
+// items stored contiguously, so traversal touches much less memory than
+// ordinary list and pointer overhead per item is divided by BlockSize.
+// Interface follows the list, but insert, erase and splice may move items
+// within the affected blocks, so iterators to items of these blocks
+// are invalidated. Iterators to items of other blocks remain valid.
+template<typename T, std::size_t BlockSize = 16, typename Allocator = std::allocator<T>>
+class unrolled_list
+{
+private:
+    struct _block;
+    using block_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<_block>;
+
+public:
+    // Type declarations
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    static_assert(BlockSize >= 2, "Unrolled list block must have space for at least two items.");
+
+    unrolled_list() = default;
+    explicit unrolled_list( const Allocator& alloc ) : m_allocator(alloc) { }
+    explicit unrolled_list( size_type count, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { resize(count); }
+    template< class InputIt >
+    unrolled_list( InputIt first, InputIt last, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { append(first, last); }
+    unrolled_list( const unrolled_list& other ) : m_allocator(std::allocator_traits<block_allocator_type>::select_on_container_copy_construction(other.m_allocator)) { append(other.begin(), other.end()); }
+    unrolled_list( unrolled_list&& other ) : m_allocator(other.m_allocator) { swap_blocks(other); }
+    unrolled_list( std::initializer_list<T> init, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { append(init.begin(), init.end()); }
+    ~unrolled_list() { clear(); }
+
+    // Assignment operator
+    unrolled_list& operator=( const unrolled_list& other );
+    unrolled_list& operator=( unrolled_list&& other );
+
+    // Assign methods
+    void assign( size_type count, const T& value ) { clear(); insert(end(), count, value); }
+    template< class InputIt, std::enable_if_t<std::is_same_v<T, typename std::iterator_traits<InputIt>::value_type>, int> = 0 >
+    void assign( InputIt first, InputIt last ) { clear(); append(first, last); }
+    void assign( std::initializer_list<T> ilist ) { assign(ilist.begin(), ilist.end()); }
+
+    template<typename Value>
+    class _iterator
+    {
+    public:
+        using value_type = Value;
+        using reference = Value&;
+        using pointer = Value*;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        _iterator(const unrolled_list* myList, _block* block, size_type index) : m_list(myList), m_block(block), m_index(index) {}
+
+        reference operator*() const { return m_block->items()[m_index]; }
+        pointer operator->() const { return m_block->items() + m_index; }
+        _iterator& operator++();
+        _iterator operator++(int) { _iterator temp = *this; ++(*this); return temp; }
+        _iterator& operator--();
+        _iterator operator--(int) { _iterator temp = *this; --(*this); return temp; }
+
+        bool operator==(const _iterator& other) const { return m_block == other.m_block && m_index == other.m_index; }
+        bool operator!=(const _iterator& other) const { return !(*this == other); }
+
+        operator _iterator<const T>() const { return _iterator<const T>(m_list, m_block, m_index); }
+
+    private:
+        friend class unrolled_list;
+
+        const unrolled_list* m_list = nullptr;
+        _block* m_block = nullptr;
+        size_type m_index = 0;
+    };
+
+    using iterator = _iterator<value_type>;
+    using const_iterator = _iterator<const value_type>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Element access
+
+    reference front() noexcept { return m_head->items()[0]; }
+    const_reference front() const noexcept { return m_head->items()[0]; }
+
+    reference back() noexcept { return m_tail->items()[m_tail->count - 1]; }
+    const_reference back() const noexcept { return m_tail->items()[m_tail->count - 1]; }
+
+    // Iterators
+
+    iterator begin() noexcept { return iterator(this, m_head, 0); }
+    const_iterator begin() const noexcept { return const_iterator(this, m_head, 0); }
+    const_iterator cbegin() const noexcept { return const_iterator(this, m_head, 0); }
+
+    iterator end() noexcept { return iterator(this, nullptr, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, nullptr, 0); }
+    const_iterator cend() const noexcept { return const_iterator(this, nullptr, 0); }
+
+    reverse_iterator rbegin() noexcept { return std::make_reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return std::make_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return std::make_reverse_iterator(cend()); }
+
+    reverse_iterator rend() noexcept { return std::make_reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return std::make_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return std::make_reverse_iterator(cbegin()); }
+
+    // Capacity methods
+    bool empty() const noexcept { return m_head == nullptr; }
+    size_type size() const noexcept { return m_size; }
+    size_type max_size() const noexcept { return std::allocator_traits<allocator_type>::max_size(get_allocator()); }
+
+    // Returns number of allocated blocks
+    size_type block_count() const noexcept { return m_blockCount; }
+    static constexpr size_type block_size() noexcept { return BlockSize; }
+
+    // Modifiers
+    void clear() noexcept;
+    void swap( unrolled_list& other );
+
+    void push_back( const value_type& item ) { emplace(end(), item); }
+    void push_back( value_type&& item ) { emplace(end(), std::move(item)); }
+    void push_front( const value_type& item ) { emplace(begin(), item); }
+    void push_front( value_type&& item ) { emplace(begin(), std::move(item)); }
+
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(std::prev(end())); }
+
+    void resize( size_type count ) { resize(count, value_type()); }
+    void resize( size_type count, const value_type& value );
+
+    // Insert
+    iterator insert( const_iterator pos, const T& value ) { return emplace(pos, value); }
+    iterator insert( const_iterator pos, T&& value ) { return emplace(pos, std::move(value)); }
+    iterator insert( const_iterator pos, size_type count, const T& value );
+    template<class InputIt, std::enable_if_t<std::is_same_v<T, typename std::remove_const<typename std::iterator_traits<InputIt>::value_type>::type>, int> = 0>
+    iterator insert( const_iterator pos, InputIt first, InputIt last );
+    iterator insert( const_iterator pos, std::initializer_list<T> ilist ) { return insert(pos, ilist.begin(), ilist.end()); }
+
+    // Erase
+    iterator erase( iterator pos ) { return erase_impl(pos, 1); }
+    iterator erase( const_iterator pos ) { return erase_impl(pos, 1); }
+    iterator erase( iterator first, iterator last ) { return erase_impl(first, std::distance(first, last)); }
+    iterator erase( const_iterator first, const_iterator last ) { return erase_impl(first, std::distance(first, last)); }
+
+    // Emplace
+    template<typename... Args>
+    reference emplace_back( Args&&... args ) { return *emplace(end(), std::forward<Args>(args)...); }
+    template<typename... Args>
+    reference emplace_front( Args&&... args ) { return *emplace(begin(), std::forward<Args>(args)...); }
+    template< class... Args >
+    iterator emplace( const_iterator pos, Args&&... args );
+
+    // Splice
+    void splice( const_iterator pos, unrolled_list& other) { splice_impl(pos, other, other.begin(), other.end()); }
+    void splice( const_iterator pos, unrolled_list&& other) { splice_impl(pos, other, other.begin(), other.end()); }
+    void splice( const_iterator pos, unrolled_list& other, const_iterator it ) { splice_impl(pos, other, it, std::next(it)); }
+    void splice( const_iterator pos, unrolled_list&& other, const_iterator it ) { splice_impl(pos, other, it, std::next(it)); }
+    void splice( const_iterator pos, unrolled_list& other, const_iterator it1, const_iterator it2 ) { splice_impl(pos, other, it1, it2); }
+    void splice( const_iterator pos, unrolled_list&& other, const_iterator it1, const_iterator it2 ) { splice_impl(pos, other, it1, it2); }
+
+    // Merge
+    void merge( unrolled_list& other ) { merge(other, std::less<T>()); }
+    void merge( unrolled_list&& other ) { merge(other, std::less<T>()); }
+    template<typename Comparator>
+    void merge( unrolled_list& other, Comparator comp ) { merge_impl(other, comp); }
+    template<typename Comparator>
+    void merge( unrolled_list&& other, Comparator comp ) { merge_impl(other, comp); }
+
+    // Sort
+    void sort() { sort(std::less<T>()); }
+    template<typename Comparator>
+    void sort( Comparator comp );
+
+    // Remove
+    size_type remove( const T& value ) { return remove_impl([&value](const T& v) { return v == value; }); }
+    template<typename UnaryPredicate>
+    size_type remove( UnaryPredicate comp ) { return remove_impl(comp); }
+
+    // Reverse
+    void reverse();
+
+    // Unique
+    size_type unique() { return unique([](const auto& l, const auto& r) { return l == r; }); }
+    template< class BinaryPredicate >
+    size_type unique( BinaryPredicate p );
+
+    allocator_type get_allocator() const { return allocator_type(m_allocator); }
+
+private:
+
+    struct _block
+    {
+        // Storage is intentionally left uninitialized
+        _block() { }
+
+        T* items() noexcept { return reinterpret_cast<T*>(storage); }
+
+        _block* prev = nullptr;
+        _block* next = nullptr;
+        size_type count = 0;
+        alignas(T) unsigned char storage[BlockSize * sizeof(T)];
+    };
+
+    // Adjacent blocks are merged, if their items occupy at most
+    // three quarters of a block. Merging of half-filled blocks would
+    // cause repeated splitting and merging on the same position.
+    static constexpr size_type merge_threshold = std::max<size_type>(BlockSize * 3 / 4, 1);
+
+    template<class InputIt>
+    void append( InputIt first, InputIt last );
+
+    template<typename... Args>
+    void construct_item( T* item, Args&&... args );
+    void destroy_items( T* items, size_type count ) noexcept;
+    _block* create_block();
+    void destroy_block( _block* block ) noexcept;
+    void link_blocks( _block* pos, _block* first, _block* last ) noexcept;
+    void unlink_blocks( _block* first, _block* last ) noexcept;
+    void swap_blocks( unrolled_list& other ) noexcept;
+    _block* split_block( _block* block, size_type index );
+    bool coalesce_blocks( _block* block );
+    void relocate_items( T* target, T* source, size_type count );
+    static void adjust_iterator( const_iterator& it, _block* block, size_type index, _block* newBlock );
+
+    iterator make_iterator( _block* block, size_type index );
+    iterator unconst_iterator( const_iterator it ) { return iterator(this, it.m_block, it.m_index); }
+    template<class... Args>
+    iterator emplace_in_block( _block* block, size_type index, Args&&... args );
+    iterator erase_impl( const_iterator pos, size_type count );
+    void splice_impl( const_iterator pos, unrolled_list& other, const_iterator first, const_iterator last );
+
+    template<typename Comparator>
+    void merge_impl( unrolled_list& other, Comparator comp );
+
+    template<typename UnaryPredicate>
+    size_type remove_impl( UnaryPredicate comp );
+
+    block_allocator_type m_allocator;
+    _block* m_head = nullptr;
+    _block* m_tail = nullptr;
+    size_type m_size = 0;
+    size_type m_blockCount = 0;
+};
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+template<typename Value>
+typename unrolled_list<T, BlockSize, Allocator>::template _iterator<Value>& unrolled_list<T, BlockSize, Allocator>::_iterator<Value>::operator++()
+{
+    if (++m_index == m_block->count)
+    {
+        m_block = m_block->next;
+        m_index = 0;
+    }
+
+    return *this;
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+template<typename Value>
+typename unrolled_list<T, BlockSize, Allocator>::template _iterator<Value>& unrolled_list<T, BlockSize, Allocator>::_iterator<Value>::operator--()
+{
+    if (!m_block || m_index == 0)
+    {
+        m_block = m_block ? m_block->prev : m_list->m_tail;
+        m_index = m_block->count;
+    }
+
+    --m_index;
+    return *this;
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+unrolled_list<T, BlockSize, Allocator>& unrolled_list<T, BlockSize, Allocator>::operator=( const unrolled_list& other )
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    if constexpr (std::allocator_traits<block_allocator_type>::propagate_on_container_copy_assignment::value)
+    {
+        m_allocator = other.m_allocator;
+    }
+
+    append(other.begin(), other.end());
+    return *this;
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+unrolled_list<T, BlockSize, Allocator>& unrolled_list<T, BlockSize, Allocator>::operator=( unrolled_list&& other )
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    if constexpr (std::allocator_traits<block_allocator_type>::propagate_on_container_move_assignment::value)
+    {
+        m_allocator = other.m_allocator;
+        swap_blocks(other);
+    }
+    else if (m_allocator == other.m_allocator)
+    {
+        swap_blocks(other);
+    }
+    else
+    {
+        // We can't release the blocks of the other list, so move the items
+        append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    }
+
+    return *this;
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+void unrolled_list<T, BlockSize, Allocator>::clear() noexcept
+{
+    while (m_head)
+    {
+        _block* block = m_head;
+        m_head = block->next;
+        destroy_items(block->items(), block->count);
+        destroy_block(block);
+    }
+
+    m_tail = nullptr;
+    m_size = 0;
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+void unrolled_list<T, BlockSize, Allocator>::swap( unrolled_list& other )
+{
+    swap_blocks(other);
+
+    if constexpr (std::allocator_traits<block_allocator_type>::propagate_on_container_swap::value)
+    {
+        std::swap(m_allocator, other.m_allocator);
+    }
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+void unrolled_list<T, BlockSize, Allocator>::resize( size_type count, const value_type& value )
+{
+    if (count < size())
+    {
+        erase(std::prev(end(), size() - count), end());
+    }
+    else
+    {
+        while (size() < count)
+        {
+            push_back(value);
+        }
+    }
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+typename unrolled_list<T, BlockSize, Allocator>::iterator unrolled_list<T, BlockSize, Allocator>::insert( const_iterator pos, size_type count, const T& value )
+{
+    for (size_type i = 0; i < count; ++i)
+    {
+        pos = insert(pos, value);
+    }
+
+    return unconst_iterator(pos);
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+template<class InputIt, std::enable_if_t<std::is_same_v<T, typename std::remove_const<typename std::iterator_traits<InputIt>::value_type>::type>, int>>
+typename unrolled_list<T, BlockSize, Allocator>::iterator unrolled_list<T, BlockSize, Allocator>::insert( const_iterator pos, InputIt first, InputIt last )
+{
+    auto it = std::make_reverse_iterator(last);
+    auto itEnd = std::make_reverse_iterator(first);
+
+    while (it != itEnd)
+    {
+        pos = insert(pos, *it++);
+    }
+
+    return unconst_iterator(pos);
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+template<class InputIt>
+void unrolled_list<T, BlockSize, Allocator>::append( InputIt first, InputIt last )
+{
+    for (; first != last; ++first)
+    {
+        emplace(end(), *first);
+    }
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+template<class... Args>
+typename unrolled_list<T, BlockSize, Allocator>::iterator unrolled_list<T, BlockSize, Allocator>::emplace( const_iterator pos, Args&&... args )
+{
+    _block* block = pos.m_block;
+    size_type index = pos.m_index;
+
+    if (!block)
+    {
+        if (!m_tail || m_tail->count == BlockSize)
+        {
+            // Start a new block, it is linked after the item is constructed,
+            // so the list never contains an empty block.
+            _block* newBlock = create_block();
+
+            try
+            {
+                construct_item(newBlock->items(), std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                destroy_block(newBlock);
+                throw;
+            }
+
+            newBlock->count = 1;
+            link_blocks(nullptr, newBlock, nullptr);
+            ++m_size;
+            return iterator(this, newBlock, 0);
+        }
+
+        block = m_tail;
+        index = block->count;
+    }
+    else if (index == 0 && block->prev && block->prev->count < BlockSize)
+    {
+        // Free space at the end of the previous block is used
+        block = block->prev;
+        index = block->count;
+    }
+    else if (block->count == BlockSize)
+    {
+        // Splitting relocates the items, arguments can refer to them,
+        // so the value is created before the block is split.
+        T value(std::forward<Args>(args)...);
+
+        constexpr size_type half = BlockSize / 2;
+        _block* newBlock = split_block(block, half);
+
+        if (index >= half)
+        {
+            block = newBlock;
+            index -= half;
+        }
+
+        return emplace_in_block(block, index, std::move(value));
+    }
+
+    return emplace_in_block(block, index, std::forward<Args>(args)...);
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+template<class... Args>
+typename unrolled_list<T, BlockSize, Allocator>::iterator unrolled_list<T, BlockSize, Allocator>::emplace_in_block( _block* block, size_type index, Args&&... args )
+{
+    // Block must have free space for the new item
+    T* items = block->items();
+    if (index == block->count)
+    {
+        construct_item(items + index, std::forward<Args>(args)...);
+    }
+    else
+    {
+        // Value is created first, arguments can refer to the items of the block
+        T value(std::forward<Args>(args)...);
+        construct_item(items + block->count, std::move(items[block->count - 1]));
+        std::move_backward(items + index, items + block->count - 1, items + block->count);
+        items[index] = std::move(value);
+    }
+
+    ++block->count;
+    ++m_size;
+    return iterator(this, block, index);
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+typename unrolled_list<T, BlockSize, Allocator>::iterator unrolled_list<T, BlockSize, Allocator>::erase_impl( const_iterator pos, size_type count )
+{
+    _block* block = pos.m_block;
+    size_type index = pos.m_index;
+
+    if (count == 0)
+        return make_iterator(block, index);
+
+    while (count > 0)
+    {
+        // Remove as many items from the current block as possible
+        T* items = block->items();
+        const size_type removed = std::min(count, block->count - index);
+        std::move(items + index + removed, items + block->count, items + index);
+        destroy_items(items + block->count - removed, removed);
+
+        block->count -= removed;
+        m_size -= removed;
+        count -= removed;
+
+        if (block->count == 0)
+        {
+            _block* next = block->next;
+            unlink_blocks(block, block);
+            destroy_block(block);
+            block = next;
+            index = 0;
+        }
+        else if (index == block->count)
+        {
+            block = block->next;
+            index = 0;
+        }
+    }
+
+    if (!block)
+    {
+        if (!m_tail)
+            return end();
+
+        block = m_tail;
+        index = m_tail->count;
+    }
+
+    // Merge underfilled blocks around the erased position
+    if (_block* prev = block->prev)
+    {
+        const size_type offset = prev->count;
+        if (coalesce_blocks(prev))
+        {
+            block = prev;
+            index += offset;
+        }
+    }
+
+    coalesce_blocks(block);
+    return make_iterator(block, index);
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+void unrolled_list<T, BlockSize, Allocator>::splice_impl( const_iterator pos, unrolled_list& other, const_iterator first, const_iterator last )
+{
+    if (first == last || (this == &other && pos == first))
+        return;
+
+    if (m_allocator != other.m_allocator)
+    {
+        // Our allocator can't release blocks of the other list,
+        // so the items must be moved into our blocks.
+        insert(pos, std::make_move_iterator(other.unconst_iterator(first)), std::make_move_iterator(other.unconst_iterator(last)));
+        other.erase(first, last);
+        return;
+    }
+
+    // Whole list is moved, so we know its size
+    const bool wholeList = first == other.cbegin() && last == other.cend();
+
+    // Split the blocks, so the range consists of whole blocks only,
+    // and the position is at the start of the block.
+    _block* posBlock = split_block(pos.m_block, pos.m_index);
+    adjust_iterator(first, pos.m_block, pos.m_index, posBlock);
+    adjust_iterator(last, pos.m_block, pos.m_index, posBlock);
+
+    _block* lastBlock = other.split_block(last.m_block, last.m_index);
+    adjust_iterator(first, last.m_block, last.m_index, lastBlock);
+
+    _block* firstBlock = other.split_block(first.m_block, first.m_index);
+    _block* rangeLast = lastBlock ? lastBlock->prev : other.m_tail;
+
+    if (this != &other)
+    {
+        size_type count = wholeList ? other.m_size : 0;
+        size_type blockCount = wholeList ? other.m_blockCount : 0;
+
+        for (_block* block = firstBlock; !wholeList; block = block->next)
+        {
+            count += block->count;
+            ++blockCount;
+
+            if (block == rangeLast)
+                break;
+        }
+
+        _block* gapPrev = firstBlock->prev;
+        other.unlink_blocks(firstBlock, rangeLast);
+        other.m_size -= count;
+        other.m_blockCount -= blockCount;
+
+        if (gapPrev)
+        {
+            other.coalesce_blocks(gapPrev);
+        }
+
+        link_blocks(posBlock, firstBlock, rangeLast);
+        m_size += count;
+        m_blockCount += blockCount;
+    }
+    else
+    {
+        unlink_blocks(firstBlock, rangeLast);
+        link_blocks(posBlock, firstBlock, rangeLast);
+    }
+
+    // Merge small blocks created by the splitting
+    coalesce_blocks(rangeLast);
+    if (firstBlock->prev)
+    {
+        coalesce_blocks(firstBlock->prev);
+    }
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+template<typename Comparator>
+void unrolled_list<T, BlockSize, Allocator>::sort( Comparator comp )
+{
+    if (size() < 2)
+        return;
+
+    // Items are sorted in a contiguous buffer, which is much faster
+    // than sorting of linked blocks, and then moved back.
+    vector<T, Allocator> buffer(get_allocator());
+    buffer.reserve(size());
+    std::move(begin(), end(), std::back_inserter(buffer));
+    std::stable_sort(buffer.begin(), buffer.end(), comp);
+    std::move(buffer.begin(), buffer.end(), begin());
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+template<typename Comparator>
+void unrolled_list<T, BlockSize, Allocator>::merge_impl( unrolled_list& other, Comparator comp )
+{
+    if (this == &other)
+        return;
+
+    // Items of the other list are inserted into the existing blocks,
+    // insertion uses free space of the blocks or splits them.
+    auto it1 = begin();
+    auto it2 = other.begin();
+    while (it1 != end() && it2 != other.end())
+    {
+        if (comp(*it2, *it1))
+        {
+            it1 = std::next(emplace(it1, std::move(*it2)));
+            ++it2;
+        }
+        else
+        {
+            ++it1;
+        }
+    }
+
+    // Rest of the other list is relinked at once, if our
+    // allocator can release its blocks, otherwise moved.
+    if (it2 != other.end())
+    {
+        if (m_allocator == other.m_allocator)
+        {
+            splice_impl(end(), other, it2, other.end());
+        }
+        else
+        {
+            append(std::make_move_iterator(it2), std::make_move_iterator(other.end()));
+        }
+    }
+
+    other.clear();
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+template<typename UnaryPredicate>
+typename unrolled_list<T, BlockSize, Allocator>::size_type unrolled_list<T, BlockSize, Allocator>::remove_impl( UnaryPredicate comp )
+{
+    // Kept items are moved to the front, the rest is erased at once
+    iterator target = begin();
+    for (iterator it = begin(); it != end(); ++it)
+    {
+        if (!comp(*it))
+        {
+            if (target != it)
+            {
+                *target = std::move(*it);
+            }
+
+            ++target;
+        }
+    }
+
+    const size_type removedItems = std::distance(target, end());
+    erase(target, end());
+    return removedItems;
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+void unrolled_list<T, BlockSize, Allocator>::reverse()
+{
+    _block* block = m_head;
+    while (block)
+    {
+        std::reverse(block->items(), block->items() + block->count);
+        std::swap(block->prev, block->next);
+        block = block->prev;
+    }
+
+    std::swap(m_head, m_tail);
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+template<class BinaryPredicate>
+typename unrolled_list<T, BlockSize, Allocator>::size_type unrolled_list<T, BlockSize, Allocator>::unique( BinaryPredicate p )
+{
+    if (empty())
+        return 0;
+
+    // Kept items are moved to the front, the rest is erased at once
+    iterator target = begin();
+    for (iterator it = std::next(begin()); it != end(); ++it)
+    {
+        if (!p(*target, *it))
+        {
+            ++target;
+
+            if (target != it)
+            {
+                *target = std::move(*it);
+            }
+        }
+    }
+
+    ++target;
+    const size_type removedItems = std::distance(target, end());
+    erase(target, end());
+    return removedItems;
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+template<typename... Args>
+void unrolled_list<T, BlockSize, Allocator>::construct_item( T* item, Args&&... args )
+{
+    std::allocator_traits<block_allocator_type>::construct(m_allocator, item, std::forward<Args>(args)...);
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+void unrolled_list<T, BlockSize, Allocator>::destroy_items( T* items, size_type count ) noexcept
+{
+    if constexpr (!std::is_trivially_destructible_v<T>)
+    {
+        for (size_type i = 0; i < count; ++i)
+            std::allocator_traits<block_allocator_type>::destroy(m_allocator, items + i);
+    }
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+typename unrolled_list<T, BlockSize, Allocator>::_block* unrolled_list<T, BlockSize, Allocator>::create_block()
+{
+    _block* block = std::allocator_traits<block_allocator_type>::allocate(m_allocator, 1);
+    std::allocator_traits<block_allocator_type>::construct(m_allocator, block);
+    ++m_blockCount;
+    return block;
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+void unrolled_list<T, BlockSize, Allocator>::destroy_block( _block* block ) noexcept
+{
+    // Items must be already destroyed or relocated
+    std::allocator_traits<block_allocator_type>::destroy(m_allocator, block);
+    std::allocator_traits<block_allocator_type>::deallocate(m_allocator, block, 1);
+    --m_blockCount;
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+void unrolled_list<T, BlockSize, Allocator>::link_blocks( _block* pos, _block* first, _block* last ) noexcept
+{
+    // Insert the chain [first, last] before the block pos (nullptr is end),
+    // last can be nullptr, if single block is inserted.
+    if (!last)
+    {
+        last = first;
+    }
+
+    _block* prev = pos ? pos->prev : m_tail;
+
+    first->prev = prev;
+    last->next = pos;
+
+    if (prev)
+    {
+        prev->next = first;
+    }
+    else
+    {
+        m_head = first;
+    }
+
+    if (pos)
+    {
+        pos->prev = last;
+    }
+    else
+    {
+        m_tail = last;
+    }
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+void unrolled_list<T, BlockSize, Allocator>::unlink_blocks( _block* first, _block* last ) noexcept
+{
+    if (first->prev)
+    {
+        first->prev->next = last->next;
+    }
+    else
+    {
+        m_head = last->next;
+    }
+
+    if (last->next)
+    {
+        last->next->prev = first->prev;
+    }
+    else
+    {
+        m_tail = first->prev;
+    }
+
+    first->prev = nullptr;
+    last->next = nullptr;
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+void unrolled_list<T, BlockSize, Allocator>::swap_blocks( unrolled_list& other ) noexcept
+{
+    std::swap(m_head, other.m_head);
+    std::swap(m_tail, other.m_tail);
+    std::swap(m_size, other.m_size);
+    std::swap(m_blockCount, other.m_blockCount);
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+typename unrolled_list<T, BlockSize, Allocator>::_block* unrolled_list<T, BlockSize, Allocator>::split_block( _block* block, size_type index )
+{
+    // Returns the block starting with the item at the index
+    if (!block || index == 0)
+        return block;
+
+    if (index == block->count)
+        return block->next;
+
+    _block* newBlock = create_block();
+    relocate_items(newBlock->items(), block->items() + index, block->count - index);
+    newBlock->count = block->count - index;
+    block->count = index;
+    link_blocks(block->next, newBlock, nullptr);
+    return newBlock;
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+bool unrolled_list<T, BlockSize, Allocator>::coalesce_blocks( _block* block )
+{
+    // Moves items of the next block into this block, if they fit
+    _block* next = block->next;
+    if (!next || block->count + next->count > merge_threshold)
+        return false;
+
+    relocate_items(block->items() + block->count, next->items(), next->count);
+    block->count += next->count;
+    unlink_blocks(next, next);
+    destroy_block(next);
+    return true;
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+void unrolled_list<T, BlockSize, Allocator>::relocate_items( T* target, T* source, size_type count )
+{
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        std::memcpy(static_cast<void*>(target), static_cast<const void*>(source), count * sizeof(T));
+    }
+    else
+    {
+        for (size_type i = 0; i < count; ++i)
+        {
+            construct_item(target + i, std::move(source[i]));
+            std::allocator_traits<block_allocator_type>::destroy(m_allocator, source + i);
+        }
+    }
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+void unrolled_list<T, BlockSize, Allocator>::adjust_iterator( const_iterator& it, _block* block, size_type index, _block* newBlock )
+{
+    // Iterator is updated after the block was split at the index
+    if (block && index > 0 && it.m_block == block && it.m_index >= index)
+    {
+        it.m_block = newBlock;
+        it.m_index -= index;
+    }
+}
+
+template<typename T, std::size_t BlockSize, typename Allocator>
+typename unrolled_list<T, BlockSize, Allocator>::iterator unrolled_list<T, BlockSize, Allocator>::make_iterator( _block* block, size_type index )
+{
+    // Position past the last item of the block is the start of the next block
+    if (block && index == block->count)
+    {
+        block = block->next;
+        index = 0;
+    }
+
+    return iterator(this, block, index);
+}
+
+} // namespace course_l01
+
+#endif // CUSTOM_UNROLLED_LIST_H
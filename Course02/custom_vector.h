@@ -21,22 +21,101 @@
 #define CUSTOM_VECTOR_H
 
 #include <memory>
+#include <memory_resource>
+#include <cstring>
+#include <type_traits>
 #include <stdexcept>
 #include <iterator>
+#include <utility>
 #include <algorithm>
 
+#include "custom_aligned.h"
+
 namespace course_l01
 {
 
+// Type is trivially relocatable, if moving an object to a new address
+// and destroying the original object is the same as copying its bytes.
+// All trivially copyable types are trivially relocatable. Other types
+// (for example types holding an owning pointer) can opt in by specializing
+// this trait. Vector then relocates its elements using memcpy.
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> { };
+
 template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Growth policies decide the new capacity of the vector, when it must grow
+// to hold at least newSize items. Returned capacity must be at least newSize.
+
+// Doubles the capacity, starting from one item. Reallocations are rare,
+// but up to half of the allocated memory can be unused.
+struct doubling_growth_policy
+{
+    static std::size_t next_capacity( std::size_t capacity, std::size_t newSize, std::size_t /* itemSize */ )
+    {
+        // Initialize capacity to one, if it is zero, we can
+        // have zero capacity at start.
+        if (capacity == 0)
+            capacity = 1;
+
+        while (capacity < newSize)
+            capacity = 2 * capacity;
+
+        return capacity;
+    }
+};
+
+// Grows the capacity by factor 1.5. There are more reallocations than with
+// doubling, but less memory is wasted, and freed blocks can be reused for
+// later allocations (sum of the previous blocks can exceed the new block).
+struct one_and_half_growth_policy
+{
+    static std::size_t next_capacity( std::size_t capacity, std::size_t newSize, std::size_t /* itemSize */ )
+    {
+        return std::max(newSize, capacity + capacity / 2);
+    }
+};
+
+// Grows the capacity by factor 1.5 and then rounds the allocated size
+// up to the size class of a typical malloc implementation (multiples of 16
+// bytes for small blocks, four classes per power of two for larger blocks).
+// Memory, which the allocator would round up anyway, is used for items.
+struct size_class_growth_policy
+{
+    static std::size_t next_capacity( std::size_t capacity, std::size_t newSize, std::size_t itemSize )
+    {
+        const std::size_t bytes = one_and_half_growth_policy::next_capacity(capacity, newSize, itemSize) * itemSize;
+        return round_to_size_class(bytes) / itemSize;
+    }
+
+    static std::size_t round_to_size_class( std::size_t bytes )
+    {
+        std::size_t step = 16;
+
+        if (bytes > 128)
+        {
+            // Step is a quarter of the highest power of two not exceeding bytes
+            std::size_t power = 128;
+            while (power <= bytes / 2)
+                power *= 2;
+
+            step = power / 4;
+        }
+
+        return (bytes + step - 1) / step * step;
+    }
+};
+
+template<typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = doubling_growth_policy>
 class vector
 {
 public:
     // Type declarations
     using value_type = T;
-    using allocator_type = std::allocator<T>;
-    using size_type = typename allocator_type::size_type;
-    using difference_type = typename allocator_type::difference_type;
+    using allocator_type = Allocator;
+    using size_type = typename std::allocator_traits<allocator_type>::size_type;
+    using difference_type = typename std::allocator_traits<allocator_type>::difference_type;
     using reference = value_type&;
     using const_reference = const value_type&;
     using pointer = typename std::allocator_traits<allocator_type>::pointer;
@@ -47,12 +126,15 @@ public:
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
     vector() = default;
-    explicit vector( size_type count ) { resize(count); }
+    explicit vector( const Allocator& alloc ) noexcept : m_allocator(alloc) { }
+    explicit vector( size_type count, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { resize(count); }
     template< class InputIt >
-    vector( InputIt first, InputIt last ) { insert(end(), first, last); }
-    vector( const vector& other ) { insert(end(), other.begin(), other.end()); }
-    vector( vector&& other ) { swap(other); }
-    vector( std::initializer_list<T> init ) { insert(end(), init.begin(), init.end()); }
+    vector( InputIt first, InputIt last, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { insert(end(), first, last); }
+    vector( const vector& other );
+    vector( const vector& other, const Allocator& alloc ) : m_allocator(alloc) { insert(end(), other.begin(), other.end()); }
+    vector( vector&& other ) noexcept : m_allocator(std::move(other.m_allocator)) { take_storage(other); }
+    vector( vector&& other, const Allocator& alloc );
+    vector( std::initializer_list<T> init, const Allocator& alloc = Allocator() ) : m_allocator(alloc) { insert(end(), init.begin(), init.end()); }
     ~vector();
 
     // Assignment operator
@@ -81,6 +163,12 @@ public:
     pointer data() noexcept { return m_data; }
     const_pointer data() const noexcept { return m_data; }
 
+    // Same as data(), but the compiler is told, that the data are aligned
+    // as the allocator guarantees (see aligned_allocator).
+    static constexpr std::size_t alignment = allocator_alignment_v<allocator_type>;
+    value_type* aligned_data() noexcept { return m_data ? assume_aligned<alignment>(std::addressof(*m_data)) : nullptr; }
+    const value_type* aligned_data() const noexcept { return m_data ? assume_aligned<alignment>(std::addressof(*m_data)) : nullptr; }
+
     // Iterators
 
     iterator begin() noexcept { return m_data; }
@@ -109,6 +197,15 @@ public:
     void resize( size_type count );
     void resize( size_type count, const value_type& value );
 
+    // Resizes the vector, new items are default-initialized, so items of
+    // trivial types (for example bytes of I/O buffer) are left uninitialized
+    // and must be overwritten before they are read.
+    void resize_default_init( size_type count );
+
+    // Appends count default-initialized items and returns pointer to the
+    // first of them, so they can be written directly (for example by read()).
+    pointer append_uninitialized( size_type count );
+
     // Modifiers
     void clear();
     void push_back( const T& item );
@@ -130,6 +227,11 @@ public:
     iterator erase( iterator first, iterator last ) { return erase_impl(first, std::distance(first, last)); }
     iterator erase( const_iterator first, const_iterator last ) { return erase_impl(first, std::distance(first, last)); }
 
+    // Remove
+    size_type remove( const T& value ) { return remove_if([&value](const T& v) { return v == value; }); }
+    template<typename UnaryPredicate>
+    size_type remove_if( UnaryPredicate p );
+
     // Emplace
     template<typename... Args>
     reference emplace_back( Args&&... args );
@@ -140,17 +242,26 @@ public:
 
 private:
     iterator erase_impl( const_iterator pos, size_type count );
+    template<typename ForwardIt>
+    void assign_range( ForwardIt first, size_type count );
+    template<typename Constructor>
+    iterator insert_impl( const_iterator pos, size_type count, Constructor construct_item );
+    void open_gap( size_type index, size_type count );
+    void close_gap( size_type index, size_type count );
+    void destroy_range( pointer first, pointer last );
     void grow(std::size_t newSize);
     void shrink();
+    void relocate( pointer destination, pointer source, size_type count );
+    void take_storage( vector& other ) noexcept;
 
     allocator_type m_allocator;
-    T* m_data = nullptr;
+    pointer m_data = nullptr;
     size_type m_size = 0;
     size_type m_capacity = 0;
 };
 
-template<typename T>
-inline typename vector<T>::reference vector<T>::at( size_type pos )
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename vector<T, Allocator, GrowthPolicy>::reference vector<T, Allocator, GrowthPolicy>::at( size_type pos )
 {
     if (!(pos < size()))
         throw std::out_of_range("vector<T>::at - index is out of range.");
@@ -158,25 +269,64 @@ inline typename vector<T>::reference vector<T>::at( size_type pos )
     return m_data[pos];
 }
 
-template<typename T>
-vector<T>::~vector()
+template<typename T, typename Allocator, typename GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::~vector()
 {
     clear();
     shrink();
 }
 
-template<typename T>
-vector<T>& vector<T>::operator=( const vector& other )
+template<typename T, typename Allocator, typename GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector( const vector& other ) :
+    m_allocator(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.m_allocator))
 {
-    clear();
-    shrink();
-
     insert(end(), other.begin(), other.end());
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector( vector&& other, const Allocator& alloc ) :
+    m_allocator(alloc)
+{
+    if (m_allocator == other.m_allocator)
+    {
+        // Memory of the other vector can be released by our allocator,
+        // so we can just take it.
+        take_storage(other);
+    }
+    else
+    {
+        // Allocators are different, we must move elements one by one
+        // into the memory obtained from our allocator.
+        insert(end(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>& vector<T, Allocator, GrowthPolicy>::operator=( const vector& other )
+{
+    if (this == &other)
+        return *this;
+
+    if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value)
+    {
+        if (m_allocator != other.m_allocator)
+        {
+            // Memory must be released by the allocator which
+            // allocated it, so we can't reuse it.
+            clear();
+            shrink();
+        }
+
+        m_allocator = other.m_allocator;
+    }
+
+    // Reuse the existing capacity
+    assign_range(other.begin(), other.size());
     return *this;
 }
 
-template<typename T>
-inline typename vector<T>::const_reference vector<T>::at( size_type pos ) const
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename vector<T, Allocator, GrowthPolicy>::const_reference vector<T, Allocator, GrowthPolicy>::at( size_type pos ) const
 {
     if (!(pos < size()))
         throw std::out_of_range("vector<T>::at - index is out of range.");
@@ -184,20 +334,59 @@ inline typename vector<T>::const_reference vector<T>::at( size_type pos ) const
     return m_data[pos];
 }
 
-template<typename T>
-inline typename vector<T>::reference vector<T>::operator[]( size_type pos )
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename vector<T, Allocator, GrowthPolicy>::reference vector<T, Allocator, GrowthPolicy>::operator[]( size_type pos )
 {
     return m_data[pos];
 }
 
-template<typename T>
-void vector<T>::resize( size_type count )
+template<typename T, typename Allocator, typename GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::resize( size_type count )
 {
-    resize(count, value_type());
+    if (count < size())
+    {
+        erase(std::prev(end(), size() - count), end());
+    }
+    else if (count > size())
+    {
+        // Value-initialize new items in place, do not copy them from temporary
+        insert_impl(cend(), count - size(), [this](pointer item)
+        {
+            std::allocator_traits<allocator_type>::construct(m_allocator, item);
+        });
+    }
 }
 
-template<typename T>
-void vector<T>::resize( size_type count, const value_type& value )
+template<typename T, typename Allocator, typename GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::resize_default_init( size_type count )
+{
+    if (count < size())
+    {
+        erase(std::prev(end(), size() - count), end());
+    }
+    else if (count > size())
+    {
+        append_uninitialized(count - size());
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::pointer vector<T, Allocator, GrowthPolicy>::append_uninitialized( size_type count )
+{
+    const size_type index = size();
+
+    // Default-initialization (placement new without parentheses) does nothing
+    // for trivial types, so the loop is optimized away entirely.
+    insert_impl(cend(), count, [](pointer item)
+    {
+        ::new (static_cast<void*>(std::addressof(*item))) value_type;
+    });
+
+    return data() + index;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::resize( size_type count, const value_type& value )
 {
     // Nothing to do?
     if (count == size())
@@ -213,16 +402,16 @@ void vector<T>::resize( size_type count, const value_type& value )
     }
 }
 
-template<typename T>
-inline void vector<T>::clear()
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void vector<T, Allocator, GrowthPolicy>::clear()
 {
     // Just erase all elements, do not shrink the vector,
     // so the behaviour is the same as for std::vector.
     erase(begin(), end());
 }
 
-template<typename T>
-inline void vector<T>::push_back( const T& item )
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void vector<T, Allocator, GrowthPolicy>::push_back( const T& item )
 {
     // Ensure the array is large enough. After
     // the call, capacity() >= size() + 1. If
@@ -237,8 +426,8 @@ inline void vector<T>::push_back( const T& item )
     ++m_size;
 }
 
-template<typename T>
-inline void vector<T>::push_back( T&& item )
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void vector<T, Allocator, GrowthPolicy>::push_back( T&& item )
 {
     // Ensure the array is large enough. After
     // the call, capacity() >= size() + 1. If
@@ -253,8 +442,8 @@ inline void vector<T>::push_back( T&& item )
     ++m_size;
 }
 
-template<typename T>
-inline void vector<T>::swap( vector& other )
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void vector<T, Allocator, GrowthPolicy>::swap( vector& other )
 {
     std::swap(m_data, other.m_data);
     std::swap(m_capacity, other.m_capacity);
@@ -266,104 +455,150 @@ inline void vector<T>::swap( vector& other )
     }
 }
 
-template<typename T>
-vector<T>& vector<T>::operator=(vector<T>&& other)
+template<typename T, typename Allocator, typename GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>& vector<T, Allocator, GrowthPolicy>::operator=(vector<T, Allocator, GrowthPolicy>&& other)
 {
-    swap(other);
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value)
+    {
+        // Release our memory by our allocator, then take both
+        // the allocator and the memory of the other vector.
+        shrink();
+        m_allocator = std::move(other.m_allocator);
+        take_storage(other);
+    }
+    else if (m_allocator == other.m_allocator)
+    {
+        // Allocator is not propagated, but it can release
+        // memory of the other vector, so we can take it.
+        shrink();
+        take_storage(other);
+    }
+    else
+    {
+        // Allocators are different, we must move elements one by one.
+        insert(end(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    }
+
     return *this;
 }
 
-template<typename T>
-void vector<T>::pop_back()
+template<typename T, typename Allocator, typename GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::take_storage( vector& other ) noexcept
+{
+    // Our storage must be already released, we just take
+    // the storage of the other vector and leave it empty.
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+    m_capacity = std::exchange(other.m_capacity, 0);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::pop_back()
 {
     erase(std::prev(end()));
 }
 
-template<typename T>
-typename vector<T>::iterator vector<T>::insert( const_iterator pos, const T& value )
+template<typename T, typename Allocator, typename GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::insert( const_iterator pos, const T& value )
 {
-    auto distance = std::distance(cbegin(), pos);
-    push_back(value);
-    return std::prev(std::rotate(begin() + distance, std::prev(end()), end()));
+    return emplace(pos, value);
 }
 
-template<typename T>
-typename vector<T>::iterator vector<T>::insert( const_iterator pos, T&& value )
+template<typename T, typename Allocator, typename GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::insert( const_iterator pos, T&& value )
 {
-    auto distance = std::distance(cbegin(), pos);
-    push_back(std::move(value));
-    return std::prev(std::rotate(begin() + distance, std::prev(end()), end()));
+    return emplace(pos, std::move(value));
 }
 
-template<typename T>
-typename vector<T>::iterator vector<T>::insert( const_iterator pos, size_type count, const T& value )
+template<typename T, typename Allocator, typename GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::insert( const_iterator pos, size_type count, const T& value )
 {
     // If we are not inserting anything, just return current iterator
     if (count == 0)
         return const_cast<iterator>(pos);
 
-    auto distance = std::distance(cbegin(), pos);
-
-    // Pre-allocate the memory, after we calculate
-    // the distance. Keep in mind, that iterator pos
-    // can be invalidated.
-    grow(size() + count);
+    // Value can be an element of this vector, which
+    // can be moved or reallocated, so we make a copy.
+    value_type copy(value);
 
-    for (size_type i = 0; i < count; ++i)
+    return insert_impl(pos, count, [this, &copy](pointer item)
     {
-        push_back(value);
-    }
-
-    std::rotate(begin() + distance, std::prev(end(), count), end());
-    return std::next(begin(), distance);
+        std::allocator_traits<allocator_type>::construct(m_allocator, item, copy);
+    });
 }
 
-template<typename T>
+template<typename T, typename Allocator, typename GrowthPolicy>
 template<class InputIt, std::enable_if_t<std::is_same_v<T, typename std::iterator_traits<InputIt>::value_type>, int>>
-typename vector<T>::iterator vector<T>::insert( const_iterator pos, InputIt first, InputIt last )
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::insert( const_iterator pos, InputIt first, InputIt last )
 {
     // If we are not inserting anything, just return current iterator
     if (first == last)
         return const_cast<iterator>(pos);
 
-    auto distance = std::distance(cbegin(), pos);
-    auto count = std::distance(first, last);
-
-    // Pre-allocate the memory, after we calculate
-    // the distance. Keep in mind, that iterator pos
-    // can be invalidated.
-    grow(size() + count);
+    using iterator_category = typename std::iterator_traits<InputIt>::iterator_category;
 
-    for (auto it = first; it != last; ++it)
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, iterator_category>)
     {
-        push_back(*it);
+        // We can traverse the range twice, so we know
+        // the count of the items before we insert them.
+        auto count = static_cast<size_type>(std::distance(first, last));
+
+        return insert_impl(pos, count, [this, &first](pointer item)
+        {
+            std::allocator_traits<allocator_type>::construct(m_allocator, item, *first);
+            ++first;
+        });
     }
+    else
+    {
+        // Single-pass iterator. We do not know the count
+        // of the items, so we can only append them. If we
+        // are not inserting at the end, we store the items
+        // into temporary vector first.
+        auto distance = std::distance(cbegin(), pos);
+
+        if (pos == cend())
+        {
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+        else
+        {
+            vector temporary(first, last, m_allocator);
+            insert(pos, std::make_move_iterator(temporary.begin()), std::make_move_iterator(temporary.end()));
+        }
 
-    std::rotate(begin() + distance, std::prev(end(), count), end());
-    return std::next(begin(), distance);
+        return std::next(begin(), distance);
+    }
 }
 
-template<typename T>
-typename vector<T>::iterator vector<T>::insert( const_iterator pos, std::initializer_list<T> ilist )
+template<typename T, typename Allocator, typename GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::insert( const_iterator pos, std::initializer_list<T> ilist )
 {
     return insert(pos, ilist.begin(), ilist.end());
 }
 
-template<typename T>
-typename vector<T>::iterator vector<T>::erase_impl( const_iterator pos, size_type count )
+template<typename T, typename Allocator, typename GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::erase_impl( const_iterator pos, size_type count )
 {
     // Do we remove something?
     if (count == 0)
         return const_cast<iterator>(pos);
 
-    // We rotate the erased items to the end
+    // Move the tail of the vector over the erased items
+    // in one pass, then destroy the moved-from items at the end.
     auto itFirst = std::next(begin(), std::distance(cbegin(), pos));
     auto itLast = std::next(itFirst, count);
-    auto it = std::rotate(itFirst, itLast, end());
+    auto it = std::move(itLast, end(), itFirst);
 
-    // Destroy allocated objects
-    for (auto it2 = it; it2 != end(); ++it2)
-        std::allocator_traits<allocator_type>::destroy(m_allocator, it2);
+    destroy_range(it, end());
 
     // Set new size of the vector
     m_size -= count;
@@ -371,8 +606,31 @@ typename vector<T>::iterator vector<T>::erase_impl( const_iterator pos, size_typ
     return itFirst;
 }
 
-template<typename T>
-void vector<T>::grow(size_t newSize)
+template<typename T, typename Allocator, typename GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::destroy_range( pointer first, pointer last )
+{
+    // Trivially destructible items need not to be destroyed
+    if constexpr (!std::is_trivially_destructible_v<T>)
+    {
+        for (; first != last; ++first)
+            std::allocator_traits<allocator_type>::destroy(m_allocator, first);
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename UnaryPredicate>
+typename vector<T, Allocator, GrowthPolicy>::size_type vector<T, Allocator, GrowthPolicy>::remove_if( UnaryPredicate p )
+{
+    // Compact the kept items to the front in one pass
+    // and then erase the rest at the end of the vector.
+    auto it = std::remove_if(begin(), end(), p);
+    auto removedItems = static_cast<size_type>(std::distance(it, end()));
+    erase(it, end());
+    return removedItems;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::grow(size_t newSize)
 {
     // If we have allocated enough space, do nothing
     if (newSize <= capacity())
@@ -382,53 +640,64 @@ void vector<T>::grow(size_t newSize)
     if (newSize > max_size())
         throw std::bad_alloc();
 
-    size_type newCapacity = capacity();
-
-    // Initialize capacity to one, if it is zero, we can
-    // have zero capacity at start.
-    if (newCapacity == 0)
-        newCapacity = 1;
-
-    while (newCapacity < newSize)
-        newCapacity = 2 * newCapacity;
+    // Growth policy decides, how much memory we will allocate
+    size_type newCapacity = GrowthPolicy::next_capacity(capacity(), newSize, sizeof(T));
+    newCapacity = std::min(std::max(newCapacity, size_type(newSize)), max_size());
 
     // Now we will allocate a new array and move all elements
     // from the old array into it. We deallocate the old array.
-    T* data = std::allocator_traits<allocator_type>::allocate(m_allocator, newCapacity);
+    pointer data = std::allocator_traits<allocator_type>::allocate(m_allocator, newCapacity);
 
-    for (size_type i = 0; i < size(); ++i)
+    relocate(data, m_data, size());
+
+    if (m_data)
     {
-        std::allocator_traits<allocator_type>::construct(m_allocator, data + i, std::move(m_data[i]));
-        std::allocator_traits<allocator_type>::destroy(m_allocator, m_data + i);
+        std::allocator_traits<allocator_type>::deallocate(m_allocator, m_data, m_capacity);
     }
 
-    std::allocator_traits<allocator_type>::deallocate(m_allocator, m_data, m_capacity);
-
     // Set new data. Size is not changed, only capacity.
     m_data = data;
     m_capacity = newCapacity;
 }
 
-template<typename T>
-void vector<T>::shrink()
+template<typename T, typename Allocator, typename GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::relocate( pointer destination, pointer source, size_type count )
 {
-    size_type newCapacity = capacity();
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        // Just copy the bytes of the whole block at once, the source
+        // objects are considered destroyed after the copy.
+        if (count > 0)
+            std::memcpy(static_cast<void*>(std::addressof(*destination)), static_cast<const void*>(std::addressof(*source)), count * sizeof(T));
+    }
+    else
+    {
+        // Move elements one by one into the destination
+        // array and destroy the source elements.
+        for (size_type i = 0; i < count; ++i)
+        {
+            std::allocator_traits<allocator_type>::construct(m_allocator, destination + i, std::move(source[i]));
+            std::allocator_traits<allocator_type>::destroy(m_allocator, source + i);
+        }
+    }
+}
 
+template<typename T, typename Allocator, typename GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::shrink()
+{
     // Capacity and size is the same - we cannot shrink
-    if (newCapacity == size())
+    if (capacity() == size())
         return;
 
-    if (m_size == 0)
-        newCapacity = 0;
-    else
-    {
-       size_type currentCapacity = newCapacity;
-       while (currentCapacity > size())
-       {
-           newCapacity = currentCapacity;
-           currentCapacity /= 2;
-       }
-    }
+    // Shrink to the capacity, which growth policy would choose
+    // for the current size, when growing from an empty vector.
+    size_type newCapacity = 0;
+    if (m_size > 0)
+        newCapacity = std::min(std::max(GrowthPolicy::next_capacity(0, size(), sizeof(T)), size()), max_size());
+
+    // Reallocation would not release any memory
+    if (newCapacity >= capacity())
+        return;
 
     if (newCapacity == 0)
     {
@@ -440,13 +709,9 @@ void vector<T>::shrink()
     {
         // Now we will allocate a new array and move all elements
         // from the old array into it. We deallocate the old array.
-        T* data = std::allocator_traits<allocator_type>::allocate(m_allocator, newCapacity);
+        pointer data = std::allocator_traits<allocator_type>::allocate(m_allocator, newCapacity);
 
-        for (size_type i = 0; i < size(); ++i)
-        {
-            std::allocator_traits<allocator_type>::construct(m_allocator, data + i, std::move(m_data[i]));
-            std::allocator_traits<allocator_type>::destroy(m_allocator, m_data + i);
-        }
+        relocate(data, m_data, size());
 
         std::allocator_traits<allocator_type>::deallocate(m_allocator, m_data, m_capacity);
 
@@ -456,15 +721,15 @@ void vector<T>::shrink()
     }
 }
 
-template<typename T>
-inline typename vector<T>::const_reference vector<T>::operator[]( size_type pos ) const
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename vector<T, Allocator, GrowthPolicy>::const_reference vector<T, Allocator, GrowthPolicy>::operator[]( size_type pos ) const
 {
     return m_data[pos];
 }
 
-template<typename T>
+template<typename T, typename Allocator, typename GrowthPolicy>
 template<typename... Args>
-typename vector<T>::reference vector<T>::emplace_back( Args&&... args )
+typename vector<T, Allocator, GrowthPolicy>::reference vector<T, Allocator, GrowthPolicy>::emplace_back( Args&&... args )
 {
     // Ensure the array is large enough. After
     // the call, capacity() >= size() + 1. If
@@ -481,37 +746,244 @@ typename vector<T>::reference vector<T>::emplace_back( Args&&... args )
     return back();
 }
 
-template<typename T>
+template<typename T, typename Allocator, typename GrowthPolicy>
 template<typename... Args>
-typename vector<T>::iterator vector<T>::emplace( const_iterator pos, Args&&... args )
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::emplace( const_iterator pos, Args&&... args )
 {
-    auto distance = std::distance(cbegin(), pos);
-    emplace_back(std::forward<Args>(args)...);
-    return std::prev(std::rotate(begin() + distance, std::prev(end()), end()));
+    if (pos == cend())
+    {
+        emplace_back(std::forward<Args>(args)...);
+        return std::prev(end());
+    }
+
+    // Arguments can refer to elements of this vector, which
+    // will be moved, so we construct the new item first.
+    value_type value(std::forward<Args>(args)...);
+
+    return insert_impl(pos, 1, [this, &value](pointer item)
+    {
+        std::allocator_traits<allocator_type>::construct(m_allocator, item, std::move(value));
+    });
 }
 
-template<typename T>
-void vector<T>::assign(size_type count, const T& value)
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename Constructor>
+typename vector<T, Allocator, GrowthPolicy>::iterator vector<T, Allocator, GrowthPolicy>::insert_impl( const_iterator pos, size_type count, Constructor construct_item )
 {
-    clear();
-    insert(end(), count, value);
+    auto index = static_cast<size_type>(std::distance(cbegin(), pos));
+
+    // Pre-allocate the memory, after we calculate
+    // the index. Keep in mind, that iterator pos
+    // can be invalidated.
+    grow(size() + count);
+
+    // Move the tail of the vector to make a gap of uninitialized
+    // memory, then construct the new items directly in the gap.
+    open_gap(index, count);
+
+    size_type constructed = 0;
+
+    try
+    {
+        for (; constructed < count; ++constructed)
+        {
+            construct_item(data() + index + constructed);
+        }
+    }
+    catch (...)
+    {
+        // Destroy the items constructed so far and move
+        // the tail back, so the vector is left unchanged.
+        for (size_type i = 0; i < constructed; ++i)
+        {
+            std::allocator_traits<allocator_type>::destroy(m_allocator, data() + index + i);
+        }
+
+        close_gap(index, count);
+        throw;
+    }
+
+    m_size += count;
+    return std::next(begin(), index);
 }
 
-template<typename T>
-void vector<T>::assign(std::initializer_list<T> ilist)
+template<typename T, typename Allocator, typename GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::open_gap( size_type index, size_type count )
 {
-    clear();
-    insert(end(), ilist.begin(), ilist.end());
+    // Capacity must be already large enough. Items [index, size())
+    // are moved to [index + count, size() + count), leaving the items
+    // [index, index + count) as uninitialized memory. Size is not changed.
+    pointer source = data() + index;
+    pointer destination = source + count;
+    const size_type tailSize = size() - index;
+
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        if (tailSize > 0)
+            std::memmove(static_cast<void*>(std::addressof(*destination)), static_cast<const void*>(std::addressof(*source)), tailSize * sizeof(T));
+    }
+    else
+    {
+        // Go backwards, so each destination is either uninitialized
+        // memory, or its item was already moved and destroyed.
+        for (size_type i = tailSize; i > 0; --i)
+        {
+            std::allocator_traits<allocator_type>::construct(m_allocator, destination + i - 1, std::move(source[i - 1]));
+            std::allocator_traits<allocator_type>::destroy(m_allocator, source + i - 1);
+        }
+    }
 }
 
-template<typename T>
+template<typename T, typename Allocator, typename GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::close_gap( size_type index, size_type count )
+{
+    // Reverse operation to open_gap. Items [index, index + count) must
+    // be uninitialized memory, items [index + count, size() + count)
+    // are moved to [index, size()). Size is not changed.
+    pointer destination = data() + index;
+    pointer source = destination + count;
+    const size_type tailSize = size() - index;
+
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        if (tailSize > 0)
+            std::memmove(static_cast<void*>(std::addressof(*destination)), static_cast<const void*>(std::addressof(*source)), tailSize * sizeof(T));
+    }
+    else
+    {
+        for (size_type i = 0; i < tailSize; ++i)
+        {
+            std::allocator_traits<allocator_type>::construct(m_allocator, destination + i, std::move(source[i]));
+            std::allocator_traits<allocator_type>::destroy(m_allocator, source + i);
+        }
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::assign(size_type count, const T& value)
+{
+    // Value can be an element of this vector, so we make a copy
+    value_type copy(value);
+
+    if (count > capacity())
+    {
+        // Existing items would be relocated only to be overwritten
+        clear();
+        shrink();
+    }
+
+    // Assign over live items, then construct or destroy the difference
+    const size_type assigned = std::min(size(), count);
+    std::fill_n(begin(), assigned, copy);
+
+    if (count > size())
+        insert(end(), count - size(), copy);
+    else
+        erase(std::next(begin(), count), end());
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::assign(std::initializer_list<T> ilist)
+{
+    assign_range(ilist.begin(), ilist.size());
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
 template<class InputIt, std::enable_if_t<std::is_same_v<T, typename std::iterator_traits<InputIt>::value_type>, int>>
-void vector<T>::assign( InputIt first, InputIt last )
+void vector<T, Allocator, GrowthPolicy>::assign( InputIt first, InputIt last )
 {
-    clear();
-    insert(end(), first, last);
+    using iterator_category = typename std::iterator_traits<InputIt>::iterator_category;
+
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, iterator_category>)
+    {
+        assign_range(first, static_cast<size_type>(std::distance(first, last)));
+    }
+    else
+    {
+        // Single-pass iterator, assign over live items as long as
+        // there are some, then append the rest, or erase the tail.
+        iterator it = begin();
+        for (; it != end() && first != last; ++it, ++first)
+            *it = *first;
+
+        if (first == last)
+            erase(it, end());
+        else
+            insert(end(), first, last);
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename ForwardIt>
+void vector<T, Allocator, GrowthPolicy>::assign_range( ForwardIt first, size_type count )
+{
+    if (count > capacity())
+    {
+        // Existing items would be relocated only to be overwritten,
+        // so release them together with the memory first.
+        clear();
+        shrink();
+        grow(count);
+    }
+
+    using source_type = std::remove_cv_t<std::remove_pointer_t<ForwardIt>>;
+
+    if constexpr (std::is_trivially_copyable_v<T> && std::is_pointer_v<ForwardIt> && std::is_same_v<source_type, T>)
+    {
+        // Items can be copied as bytes, no item needs to be
+        // constructed or destroyed, so copy the whole range at once.
+        if (count > 0)
+            std::memmove(static_cast<void*>(std::addressof(*data())), static_cast<const void*>(first), count * sizeof(T));
+
+        m_size = count;
+    }
+    else
+    {
+        // Assign over live items, then construct or destroy the difference
+        const size_type assigned = std::min(size(), count);
+        for (size_type i = 0; i < assigned; ++i, ++first)
+            m_data[i] = *first;
+
+        if (count > size())
+        {
+            insert_impl(cend(), count - size(), [this, &first](pointer item)
+            {
+                std::allocator_traits<allocator_type>::construct(m_allocator, item, *first);
+                ++first;
+            });
+        }
+        else
+        {
+            erase(std::next(begin(), count), end());
+        }
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy, typename UnaryPredicate>
+typename vector<T, Allocator, GrowthPolicy>::size_type erase_if( vector<T, Allocator, GrowthPolicy>& c, UnaryPredicate p )
+{
+    return c.remove_if(p);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy, typename U>
+typename vector<T, Allocator, GrowthPolicy>::size_type erase( vector<T, Allocator, GrowthPolicy>& c, const U& value )
+{
+    return c.remove_if([&value](const T& v) { return v == value; });
 }
 
+// Vector, whose data are aligned to the Alignment bytes (for example to
+// the width of AVX registers, or to the cache line).
+template<typename T, std::size_t Alignment = 64>
+using aligned_vector = vector<T, aligned_allocator<T, Alignment>>;
+
+namespace pmr
+{
+
+template<typename T>
+using vector = course_l01::vector<T, std::pmr::polymorphic_allocator<T>>;
+
+}   // namespace pmr
+
 }   // namespace course_l01
 
-#endif // CUSTOM_ARRAY_H
+#endif // CUSTOM_VECTOR_H
@@ -0,0 +1,203 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#ifndef CUSTOM_WORK_STEALING_DEQUE_H
+#define CUSTOM_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <type_traits>
+
+#include "custom_vector.h"
+#include "custom_aligned.h"
+
+namespace course_l01
+{
+
+// Work-stealing deque (Chase-Lev, in the formulation for weak memory
+// models by Le, Pop, Cohen and Zappa Nardelli). The owner thread pushes
+// and pops items at the bottom like a stack, other threads (thieves)
+// steal items from the top. Owner and thieves synchronize only when
+// they compete for the last item. Buffer is circular and grows, when it
+// is full. Old buffers are kept until the deque is destroyed, because
+// a thief may still read from them.
+//
+// Items are copied by atomic loads and stores, so they must be trivially
+// copyable (typically pointers to tasks).
+template<typename T>
+class work_stealing_deque
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Items of work stealing deque must be trivially copyable.");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    // Capacity is rounded up to a power of two
+    explicit work_stealing_deque( size_type capacity = 64 );
+    work_stealing_deque( const work_stealing_deque& ) = delete;
+    work_stealing_deque& operator=( const work_stealing_deque& ) = delete;
+    ~work_stealing_deque();
+
+    // Size is exact only if no thread is modifying the deque
+    bool empty() const noexcept { return size() == 0; }
+    size_type size() const noexcept;
+    size_type capacity() const noexcept { return m_buffer.load(std::memory_order_relaxed)->capacity; }
+
+    // Owner only
+    void push( const value_type& value );
+    bool pop( value_type& value ) noexcept;
+
+    // Any thread, returns false, if the deque is empty
+    // or other thread has taken the item meanwhile.
+    bool steal( value_type& value ) noexcept;
+
+private:
+    struct _buffer
+    {
+        size_type capacity = 0;
+        size_type mask = 0;
+        std::unique_ptr<std::atomic<T>[]> items;
+
+        explicit _buffer( size_type newCapacity ) : capacity(newCapacity), mask(newCapacity - 1), items(new std::atomic<T>[newCapacity]) { }
+
+        T load( std::int64_t index ) const noexcept { return items[size_type(index) & mask].load(std::memory_order_relaxed); }
+        void store( std::int64_t index, const T& value ) noexcept { items[size_type(index) & mask].store(value, std::memory_order_relaxed); }
+    };
+
+    _buffer* grow( _buffer* buffer, std::int64_t bottom, std::int64_t top );
+
+    // Thieves update the top, owner updates the bottom
+    alignas(cache_line_size) std::atomic<std::int64_t> m_top = 0;
+    alignas(cache_line_size) std::atomic<std::int64_t> m_bottom = 0;
+    std::atomic<_buffer*> m_buffer = nullptr;
+    vector<std::unique_ptr<_buffer>> m_buffers;
+};
+
+template<typename T>
+work_stealing_deque<T>::work_stealing_deque( size_type capacity )
+{
+    size_type newCapacity = 2;
+    while (newCapacity < capacity)
+    {
+        newCapacity *= 2;
+    }
+
+    m_buffers.push_back(std::make_unique<_buffer>(newCapacity));
+    m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+}
+
+template<typename T>
+work_stealing_deque<T>::~work_stealing_deque() = default;
+
+template<typename T>
+typename work_stealing_deque<T>::size_type work_stealing_deque<T>::size() const noexcept
+{
+    const std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+    const std::int64_t top = m_top.load(std::memory_order_acquire);
+    return bottom > top ? size_type(bottom - top) : 0;
+}
+
+template<typename T>
+void work_stealing_deque<T>::push( const value_type& value )
+{
+    const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    const std::int64_t top = m_top.load(std::memory_order_acquire);
+    _buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+
+    if (bottom - top > std::int64_t(buffer->capacity) - 1)
+    {
+        buffer = grow(buffer, bottom, top);
+    }
+
+    buffer->store(bottom, value);
+
+    // Release store publishes the item to the thieves
+    m_bottom.store(bottom + 1, std::memory_order_release);
+}
+
+template<typename T>
+bool work_stealing_deque<T>::pop( value_type& value ) noexcept
+{
+    // Reserve the bottom item first, then check whether a thief
+    // has not taken it. Full fence orders the store before the load.
+    const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    _buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = m_top.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        // Deque was empty
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    value = buffer->load(bottom);
+
+    if (top == bottom)
+    {
+        // Last item, owner competes with the thieves for it
+        const bool taken = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return taken;
+    }
+
+    return true;
+}
+
+template<typename T>
+bool work_stealing_deque<T>::steal( value_type& value ) noexcept
+{
+    std::int64_t top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom)
+        return false;
+
+    // Item must be read before the top is claimed, after a successful
+    // claim the owner may overwrite the slot by a new item.
+    _buffer* buffer = m_buffer.load(std::memory_order_acquire);
+    value = buffer->load(top);
+
+    return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+template<typename T>
+typename work_stealing_deque<T>::_buffer* work_stealing_deque<T>::grow( _buffer* buffer, std::int64_t bottom, std::int64_t top )
+{
+    auto newBuffer = std::make_unique<_buffer>(buffer->capacity * 2);
+    for (std::int64_t i = top; i < bottom; ++i)
+    {
+        newBuffer->store(i, buffer->load(i));
+    }
+
+    // Old buffer is retired, but not released
+    m_buffers.push_back(std::move(newBuffer));
+    _buffer* result = m_buffers.back().get();
+    m_buffer.store(result, std::memory_order_release);
+    return result;
+}
+
+}   // namespace course_l01
+
+#endif // CUSTOM_WORK_STEALING_DEQUE_H
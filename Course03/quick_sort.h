@@ -27,6 +27,9 @@
 namespace course03
 {
 
+template<typename Iterator, typename Comparator>
+void quick_sort_impl(Iterator begin, Iterator end, const Comparator& comparator);
+
 template<typename Iterator, typename Comparator = std::less<typename std::iterator_traits<Iterator>::value_type>>
 void quick_sort(Iterator begin, Iterator end, const Comparator& comparator = Comparator())
 {
@@ -38,8 +41,8 @@ void quick_sort(Iterator begin, Iterator end, const Comparator& comparator = Com
     quick_sort_impl(begin, end, comparator);
 }
 
-template<typename Iterator, typename Comparator = std::less<typename std::iterator_traits<Iterator>::value_type>>
-void quick_sort_impl(Iterator begin, Iterator end, const Comparator& comparator = Comparator())
+template<typename Iterator, typename Comparator>
+void quick_sort_impl(Iterator begin, Iterator end, const Comparator& comparator)
 {
     // If the number of elements in the iterator range is zero or one,
     // no action is needed, as these items are implicitly sorted.
@@ -21,6 +21,7 @@
 #define SELECTION_SORT_H
 
 #include <iterator>
+#include <algorithm>
 
 namespace course03
 {
@@ -163,4 +163,18 @@ TEST_CASE("[array] max_size")
     CHECK_EQ(array1.max_size(), 6);
 }
 
+TEST_CASE("[array] alignment")
+{
+    course_l01::array<float, 8, 32> array1 = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    course_l01::array<char, 3, 64> array2[2] = { { 'a', 'b', 'c' }, { 'd', 'e', 'f' } };
+
+    CHECK_EQ(alignof(decltype(array1)), 32);
+    CHECK_EQ(reinterpret_cast<std::uintptr_t>(array1.aligned_data()) % 32, 0);
+    CHECK_EQ(array1.aligned_data(), array1.data());
+    CHECK_EQ(array1[7], 8);
+
+    CHECK_EQ(reinterpret_cast<std::uintptr_t>(array2[1].data()) % 64, 0);
+    CHECK_EQ(array2[1].front(), 'd');
+}
+
 TEST_SUITE_END();
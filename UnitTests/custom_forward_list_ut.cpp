@@ -0,0 +1,328 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#include "custom_forward_list.h"
+#include "doctest.h"
+
+#include <forward_list>
+#include <random>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+
+template<typename T, typename Allocator>
+void test_forward_list_equality(const course_l01::forward_list<T, Allocator>& v1, const std::forward_list<T>& v2)
+{
+    CHECK_EQ(v1.empty(), v2.empty());
+    CHECK_EQ(v1.size(), static_cast<size_t>(std::distance(v2.begin(), v2.end())));
+    CHECK_EQ(v1.size(), static_cast<size_t>(std::distance(v1.begin(), v1.end())));
+
+    CHECK(std::equal(v1.begin(), v1.end(), v2.begin(), v2.end()));
+    CHECK(std::equal(v1.cbegin(), v1.cend(), v2.cbegin(), v2.cend()));
+
+    if (!v1.empty())
+    {
+        CHECK_EQ(v1.front(), v2.front());
+        CHECK_EQ(v1.back(), *std::next(v2.begin(), std::distance(v2.begin(), v2.end()) - 1));
+    }
+}
+
+TEST_SUITE_BEGIN("forward_list");
+
+TEST_CASE("[forward_list] constructors")
+{
+    std::forward_list<int> list2 = { 1, 2, 3, 4, 5 };
+
+    course_l01::forward_list<int> list1 = { 1, 2, 3, 4, 5 };
+    test_forward_list_equality(list1, list2);
+
+    course_l01::forward_list<int> list3(list1);
+    test_forward_list_equality(list3, list2);
+
+    course_l01::forward_list<int> list4(std::move(list3));
+    test_forward_list_equality(list4, list2);
+    test_forward_list_equality(list3, std::forward_list<int>());
+
+    // Moved-from list is still usable
+    list3.push_back(7);
+    test_forward_list_equality(list3, std::forward_list<int>{ 7 });
+
+    course_l01::forward_list<int> list5(list2.begin(), list2.end());
+    test_forward_list_equality(list5, list2);
+
+    course_l01::forward_list<int> list6(3);
+    test_forward_list_equality(list6, std::forward_list<int>(3));
+
+    list6 = list1;
+    test_forward_list_equality(list6, list2);
+
+    list6 = std::move(list3);
+    test_forward_list_equality(list6, std::forward_list<int>{ 7 });
+
+    list6.assign(4, 2);
+    test_forward_list_equality(list6, std::forward_list<int>(4, 2));
+
+    list6.swap(list1);
+    test_forward_list_equality(list6, list2);
+    test_forward_list_equality(list1, std::forward_list<int>(4, 2));
+}
+
+TEST_CASE("[forward_list] insert and erase after")
+{
+    course_l01::forward_list<std::string> list1;
+    std::forward_list<std::string> list2;
+
+    list1.push_front("b");
+    list2.push_front("b");
+    list1.emplace_front(2, 'a');
+    list2.emplace_front(2, 'a');
+    list1.push_back("c");
+    list2.insert_after(std::next(list2.begin()), "c");
+    test_forward_list_equality(list1, list2);
+
+    auto it1 = list1.insert_after(list1.begin(), 3, "x");
+    auto it2 = list2.insert_after(list2.begin(), 3, "x");
+    CHECK_EQ(*it1, *it2);
+    test_forward_list_equality(list1, list2);
+
+    it1 = list1.insert_after(list1.before_begin(), { "p", "q" });
+    it2 = list2.insert_after(list2.before_begin(), { "p", "q" });
+    CHECK_EQ(*it1, *it2);
+    test_forward_list_equality(list1, list2);
+
+    it1 = list1.emplace_after(it1, 3, 'e');
+    it2 = list2.emplace_after(it2, 3, 'e');
+    test_forward_list_equality(list1, list2);
+
+    it1 = list1.erase_after(list1.begin());
+    it2 = list2.erase_after(list2.begin());
+    CHECK_EQ(*it1, *it2);
+    test_forward_list_equality(list1, list2);
+
+    it1 = list1.erase_after(list1.begin(), std::next(list1.begin(), 4));
+    it2 = list2.erase_after(list2.begin(), std::next(list2.begin(), 4));
+    CHECK_EQ(*it1, *it2);
+    test_forward_list_equality(list1, list2);
+
+    // Erase of the last item updates the back
+    list1.erase_after(std::next(list1.begin(), list1.size() - 2));
+    list2.erase_after(std::next(list2.begin(), std::distance(list2.begin(), list2.end()) - 2));
+    test_forward_list_equality(list1, list2);
+
+    list1.resize(8, "r");
+    list2.resize(8, "r");
+    test_forward_list_equality(list1, list2);
+
+    list1.resize(2);
+    list2.resize(2);
+    test_forward_list_equality(list1, list2);
+
+    while (!list1.empty())
+    {
+        list1.pop_front();
+        list2.pop_front();
+        test_forward_list_equality(list1, list2);
+    }
+
+    list1.push_back("z");
+    list2.push_front("z");
+    test_forward_list_equality(list1, list2);
+}
+
+TEST_CASE("[forward_list] splice after")
+{
+    course_l01::forward_list<int> list1 = { 1, 2, 3, 4 };
+    course_l01::forward_list<int> list2 = { 10, 20, 30, 40, 50 };
+    std::forward_list<int> list3 = { 1, 2, 3, 4 };
+    std::forward_list<int> list4 = { 10, 20, 30, 40, 50 };
+
+    list1.splice_after(list1.begin(), list2, list2.begin());
+    list3.splice_after(list3.begin(), list4, list4.begin());
+    test_forward_list_equality(list1, list3);
+    test_forward_list_equality(list2, list4);
+
+    // Range with the last item, back of both lists changes
+    list1.splice_after(std::next(list1.begin(), 4), list2, std::next(list2.begin()), list2.end());
+    list3.splice_after(std::next(list3.begin(), 4), list4, std::next(list4.begin()), list4.end());
+    test_forward_list_equality(list1, list3);
+    test_forward_list_equality(list2, list4);
+
+    // Within the same list
+    list1.splice_after(list1.before_begin(), list1, std::next(list1.begin(), 2), list1.end());
+    list3.splice_after(list3.before_begin(), list3, std::next(list3.begin(), 2), list3.end());
+    test_forward_list_equality(list1, list3);
+
+    list1.splice_after(list1.before_begin(), list2);
+    list3.splice_after(list3.before_begin(), list4);
+    test_forward_list_equality(list1, list3);
+    test_forward_list_equality(list2, list4);
+
+    list2.splice_after(list2.before_begin(), list1);
+    list4.splice_after(list4.before_begin(), list3);
+    test_forward_list_equality(list1, list3);
+    test_forward_list_equality(list2, list4);
+
+    list2.push_back(100);
+    list4.insert_after(std::next(list4.begin(), std::distance(list4.begin(), list4.end()) - 1), 100);
+    test_forward_list_equality(list2, list4);
+}
+
+TEST_CASE("[forward_list] operations")
+{
+    std::mt19937 generator(3);
+
+    course_l01::forward_list<int> list1;
+    std::forward_list<int> list2;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        const int value = generator() % 100;
+        list1.push_front(value);
+        list2.push_front(value);
+    }
+
+    list1.sort(std::greater<int>());
+    list2.sort(std::greater<int>());
+    test_forward_list_equality(list1, list2);
+
+    list1.sort();
+    list2.sort();
+    test_forward_list_equality(list1, list2);
+
+    course_l01::forward_list<int> list3 = { -1, 5, 50, 500 };
+    std::forward_list<int> list4 = { -1, 5, 50, 500 };
+    list1.merge(list3);
+    list2.merge(list4);
+    test_forward_list_equality(list1, list2);
+    test_forward_list_equality(list3, list4);
+
+    CHECK_EQ(list1.unique(), 1902);
+    list2.unique();
+    test_forward_list_equality(list1, list2);
+
+    list1.reverse();
+    list2.reverse();
+    test_forward_list_equality(list1, list2);
+
+    CHECK_EQ(list1.remove([](int value) { return value % 2 == 1; }), 50);
+    list2.remove_if([](int value) { return value % 2 == 1; });
+    test_forward_list_equality(list1, list2);
+
+    CHECK_EQ(list1.remove(500), 1);
+    list2.remove(500);
+    test_forward_list_equality(list1, list2);
+}
+
+TEST_CASE("[forward_list] sort stability")
+{
+    course_l01::forward_list<std::pair<int, int>> list1;
+    std::forward_list<std::pair<int, int>> list2;
+
+    for (int i = 0; i < 500; ++i)
+    {
+        list1.emplace_front((i * 7) % 13, i);
+        list2.emplace_front((i * 7) % 13, i);
+    }
+
+    auto comp = [](const auto& l, const auto& r) { return l.first < r.first; };
+    list1.sort(comp);
+    list2.sort(comp);
+    test_forward_list_equality(list1, list2);
+}
+
+TEST_CASE("[forward_list] sort throwing comparator")
+{
+    course_l01::forward_list<int> list1;
+    for (int i = 0; i < 100; ++i)
+    {
+        list1.push_back((i * 37) % 101);
+    }
+
+    int calls = 0;
+    auto comp = [&calls](int l, int r)
+    {
+        if (++calls == 150)
+        {
+            throw std::runtime_error("comparison failed");
+        }
+        return l < r;
+    };
+
+    CHECK_THROWS_AS(list1.sort(comp), std::runtime_error);
+
+    // No item is lost and the tail is still valid
+    CHECK_EQ(list1.size(), 100);
+    CHECK_EQ(std::distance(list1.begin(), list1.end()), 100);
+    list1.push_back(101);
+    CHECK_EQ(list1.back(), 101);
+
+    list1.sort();
+    CHECK(std::is_sorted(list1.begin(), list1.end()));
+    CHECK_EQ(list1.front(), 0);
+    CHECK_EQ(list1.back(), 101);
+}
+
+TEST_CASE("[forward_list] pooled nodes")
+{
+    course_l01::pooled_forward_list<int> list1 = { 1, 2, 3 };
+    std::forward_list<int> list2 = { 1, 2, 3 };
+
+    // Released node is recycled by the next allocation
+    const int* address = &list1.front();
+    list1.pop_front();
+    list2.pop_front();
+    list1.push_back(4);
+    list2.insert_after(std::next(list2.begin()), 4);
+    CHECK_EQ(&list1.back(), address);
+    test_forward_list_equality(list1, list2);
+
+    course_l01::pooled_forward_list<int> list3(list1.get_allocator());
+    list3.splice_after(list3.before_begin(), list1);
+    test_forward_list_equality(list3, list2);
+    CHECK(list1.empty());
+}
+
+TEST_CASE("[forward_list] splice between pooled lists")
+{
+    // Default pooled lists share the default pool resource
+    course_l01::pooled_forward_list<int> list1;
+    {
+        course_l01::pooled_forward_list<int> list2 = { 1, 2, 3 };
+        CHECK(list1.get_allocator() == list2.get_allocator());
+        list1.splice_after(list1.before_begin(), list2);
+    }
+    test_forward_list_equality(list1, std::forward_list<int>{ 1, 2, 3 });
+
+    // Lists with different pool resources move the items instead of relinking
+    course_l01::pool_allocator<int> allocator(std::make_shared<course_l01::pool_resource>());
+    {
+        course_l01::pooled_forward_list<int> list2({ 0, 4, 5, 6 }, allocator);
+        CHECK(list1.get_allocator() != list2.get_allocator());
+        list1.splice_after(list1.before_begin(), list2, list2.before_begin());
+        list1.merge(list2);
+        CHECK(list2.empty());
+
+        course_l01::pooled_forward_list<int> list3({ 7, 8 }, allocator);
+        list1.splice_after(std::next(list1.before_begin(), 7), list3);
+        CHECK(list3.empty());
+    }
+    test_forward_list_equality(list1, std::forward_list<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8 });
+}
+
+TEST_SUITE_END();
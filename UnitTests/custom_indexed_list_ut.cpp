@@ -0,0 +1,220 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+
+#include "custom_indexed_list.h"
+#include "doctest.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+
+template<typename T>
+void test_indexed_list_equality(const course_l01::indexed_list<T>& v1, const std::vector<T>& v2)
+{
+    CHECK_EQ(v1.empty(), v2.empty());
+    CHECK_EQ(v1.size(), v2.size());
+    CHECK_EQ(std::distance(v1.begin(), v1.end()), std::distance(v2.begin(), v2.end()));
+    CHECK(std::equal(v1.begin(), v1.end(), v2.begin(), v2.end()));
+    CHECK(std::equal(v1.rbegin(), v1.rend(), v2.rbegin(), v2.rend()));
+
+    for (size_t i = 0; i < v2.size(); ++i)
+    {
+        CHECK_EQ(v1[i], v2[i]);
+    }
+}
+
+}   // namespace
+
+TEST_SUITE_BEGIN("indexed_list");
+
+TEST_CASE("[indexed_list] constructors and assignment")
+{
+    course_l01::indexed_list<int> list1;
+    course_l01::indexed_list<int> list2(5);
+    course_l01::indexed_list<int> list3 = { 1, 2, 3, 4, 5 };
+    std::vector<int> values = { 7, 8, 9 };
+    course_l01::indexed_list<int> list4(values.begin(), values.end());
+
+    test_indexed_list_equality(list1, {});
+    test_indexed_list_equality(list2, { 0, 0, 0, 0, 0 });
+    test_indexed_list_equality(list3, { 1, 2, 3, 4, 5 });
+    test_indexed_list_equality(list4, values);
+
+    course_l01::indexed_list<int> list5(list3);
+    test_indexed_list_equality(list5, { 1, 2, 3, 4, 5 });
+
+    course_l01::indexed_list<int> list6(std::move(list5));
+    test_indexed_list_equality(list5, {});
+    test_indexed_list_equality(list6, { 1, 2, 3, 4, 5 });
+
+    list1 = list4;
+    test_indexed_list_equality(list1, values);
+    list1 = std::move(list6);
+    test_indexed_list_equality(list1, { 1, 2, 3, 4, 5 });
+
+    list1.swap(list4);
+    test_indexed_list_equality(list1, values);
+    test_indexed_list_equality(list4, { 1, 2, 3, 4, 5 });
+
+    list1.assign(3, 4);
+    test_indexed_list_equality(list1, { 4, 4, 4 });
+    list1.assign({ 5, 6 });
+    test_indexed_list_equality(list1, { 5, 6 });
+}
+
+TEST_CASE("[indexed_list] positional access")
+{
+    course_l01::indexed_list<int> list1;
+    for (int i = 0; i < 1000; ++i)
+    {
+        list1.push_back(i);
+    }
+
+    for (size_t i = 0; i < list1.size(); ++i)
+    {
+        CHECK_EQ(list1[i], int(i));
+        CHECK_EQ(list1.index_of(list1.nth(i)), i);
+    }
+
+    CHECK(list1.nth(list1.size()) == list1.end());
+    CHECK_EQ(list1.index_of(list1.end()), list1.size());
+    CHECK_EQ(list1.front(), 0);
+    CHECK_EQ(list1.back(), 999);
+    CHECK_EQ(list1.at(500), 500);
+    CHECK_THROWS_AS(list1.at(1000), std::out_of_range);
+
+    list1.insert(size_t(500), -1);
+    CHECK_EQ(list1[500], -1);
+    CHECK_EQ(list1[501], 500);
+    list1.erase(size_t(500));
+    CHECK_EQ(list1[500], 500);
+}
+
+TEST_CASE("[indexed_list] stable iterators")
+{
+    course_l01::indexed_list<std::string> list1;
+    std::vector<course_l01::indexed_list<std::string>::iterator> iterators;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        iterators.push_back(list1.insert(list1.end(), std::to_string(i)));
+    }
+
+    // Insertions and erasures elsewhere don't invalidate iterators
+    for (int i = 0; i < 100; ++i)
+    {
+        list1.insert(size_t(i * 2), "x");
+    }
+    list1.remove(std::string("x"));
+    list1.erase(iterators[50]);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        if (i == 50)
+            continue;
+
+        CHECK_EQ(*iterators[i], std::to_string(i));
+        CHECK_EQ(list1.index_of(iterators[i]), size_t(i < 50 ? i : i - 1));
+    }
+}
+
+TEST_CASE("[indexed_list] random operations")
+{
+    course_l01::indexed_list<int> list1;
+    std::vector<int> list2;
+
+    std::mt19937 generator(42);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        const size_t index = list2.empty() ? 0 : generator() % (list2.size() + 1);
+
+        switch (generator() % 6)
+        {
+            case 0:
+            case 1:
+                list1.insert(index, i);
+                list2.insert(list2.begin() + index, i);
+                break;
+
+            case 2:
+                list1.emplace(list1.nth(index), i);
+                list2.emplace(list2.begin() + index, i);
+                break;
+
+            case 3:
+                if (index < list2.size())
+                {
+                    list1.erase(index);
+                    list2.erase(list2.begin() + index);
+                }
+                break;
+
+            case 4:
+                list1.push_front(i);
+                list2.insert(list2.begin(), i);
+                break;
+
+            case 5:
+                if (index < list2.size())
+                {
+                    list1[index] = -i;
+                    list2[index] = -i;
+                }
+                break;
+        }
+
+        REQUIRE_EQ(list1.size(), list2.size());
+    }
+
+    test_indexed_list_equality(list1, list2);
+
+    list1.reverse();
+    std::reverse(list2.begin(), list2.end());
+    test_indexed_list_equality(list1, list2);
+
+    list1.erase(list1.nth(100), list1.nth(1000));
+    list2.erase(list2.begin() + 100, list2.begin() + 1000);
+    test_indexed_list_equality(list1, list2);
+
+    list1.resize(10);
+    list2.resize(10);
+    test_indexed_list_equality(list1, list2);
+
+    list1.resize(20, 3);
+    list2.resize(20, 3);
+    test_indexed_list_equality(list1, list2);
+
+    list1.pop_front();
+    list1.pop_back();
+    list2.erase(list2.begin());
+    list2.pop_back();
+    test_indexed_list_equality(list1, list2);
+
+    list1.clear();
+    test_indexed_list_equality(list1, {});
+}
+
+TEST_SUITE_END();
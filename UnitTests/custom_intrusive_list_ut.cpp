@@ -0,0 +1,291 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#include "custom_intrusive_list.h"
+#include "doctest.h"
+
+#include <list>
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <algorithm>
+
+namespace
+{
+
+struct Connection
+{
+    Connection( int value ) : id(value) { }
+
+    bool operator==( const Connection& other ) const { return id == other.id; }
+    bool operator<( const Connection& other ) const { return id < other.id; }
+
+    double payload = 0.0;
+    int id = 0;
+    course_l01::intrusive_list_hook hook;
+    course_l01::intrusive_list_hook timerHook;
+};
+
+using connection_list = course_l01::intrusive_list<Connection, &Connection::hook>;
+using timer_list = course_l01::intrusive_list<Connection, &Connection::timerHook>;
+
+template<typename List>
+void test_intrusive_list_equality(const List& v1, const std::list<int>& v2)
+{
+    CHECK_EQ(v1.empty(), v2.empty());
+    CHECK_EQ(v1.size(), v2.size());
+    CHECK_EQ(std::distance(v1.begin(), v1.end()), std::distance(v2.begin(), v2.end()));
+
+    auto equal = [](const Connection& l, int r) { return l.id == r; };
+    CHECK(std::equal(v1.begin(), v1.end(), v2.begin(), v2.end(), equal));
+    CHECK(std::equal(v1.rbegin(), v1.rend(), v2.rbegin(), v2.rend(), equal));
+}
+
+}   // namespace
+
+TEST_SUITE_BEGIN("intrusive_list");
+
+TEST_CASE("[intrusive_list] insert and erase")
+{
+    std::vector<Connection> connections(10, Connection(0));
+    for (int i = 0; i < 10; ++i)
+    {
+        connections[i].id = i;
+    }
+
+    connection_list list1;
+    std::list<int> list2;
+
+    list1.push_back(connections[1]);
+    list2.push_back(1);
+    list1.push_front(connections[0]);
+    list2.push_front(0);
+    list1.insert(list1.end(), connections.begin() + 2, connections.begin() + 6);
+    list2.insert(list2.end(), { 2, 3, 4, 5 });
+    test_intrusive_list_equality(list1, list2);
+
+    CHECK(connections[3].hook.is_linked());
+    CHECK_FALSE(connections[3].timerHook.is_linked());
+    CHECK_EQ(&*list1.iterator_to(connections[3]), &connections[3]);
+
+    // Object can be linked in two lists through different hooks
+    timer_list list3;
+    list3.push_back(connections[3]);
+    list3.push_back(connections[8]);
+    CHECK_EQ(list3.front().id, 3);
+    CHECK_EQ(list3.back().id, 8);
+
+    list1.erase(list1.iterator_to(connections[3]));
+    list2.remove(3);
+    test_intrusive_list_equality(list1, list2);
+    CHECK_FALSE(connections[3].hook.is_linked());
+    CHECK(connections[3].timerHook.is_linked());
+
+    list1.pop_front();
+    list2.pop_front();
+    list1.pop_back();
+    list2.pop_back();
+    test_intrusive_list_equality(list1, list2);
+
+    // Copy of the object is not linked
+    Connection copy = list1.front();
+    CHECK_FALSE(copy.hook.is_linked());
+
+    list1.erase(list1.begin(), list1.end());
+    list2.clear();
+    test_intrusive_list_equality(list1, list2);
+
+    list3.clear();
+    CHECK_FALSE(connections[8].timerHook.is_linked());
+}
+
+TEST_CASE("[intrusive_list] move between lists")
+{
+    std::vector<Connection> connections;
+    for (int i = 0; i < 10; ++i)
+    {
+        connections.emplace_back(i);
+    }
+
+    connection_list list1(connections.begin(), connections.end());
+    connection_list list2;
+    std::list<int> list3 = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    std::list<int> list4;
+
+    list2.splice(list2.end(), list1, list1.iterator_to(connections[4]));
+    list4.splice(list4.end(), list3, std::next(list3.begin(), 4));
+    test_intrusive_list_equality(list1, list3);
+    test_intrusive_list_equality(list2, list4);
+
+    list2.splice(list2.begin(), list1, std::next(list1.begin(), 2), std::prev(list1.end(), 2));
+    list4.splice(list4.begin(), list3, std::next(list3.begin(), 2), std::prev(list3.end(), 2));
+    test_intrusive_list_equality(list1, list3);
+    test_intrusive_list_equality(list2, list4);
+
+    list1.splice(std::next(list1.begin()), list2);
+    list3.splice(std::next(list3.begin()), list4);
+    test_intrusive_list_equality(list1, list3);
+    test_intrusive_list_equality(list2, list4);
+
+    connection_list list5(std::move(list1));
+    test_intrusive_list_equality(list5, list3);
+    test_intrusive_list_equality(list1, std::list<int>());
+
+    list1 = std::move(list5);
+    test_intrusive_list_equality(list1, list3);
+
+    list1.swap(list2);
+    test_intrusive_list_equality(list2, list3);
+    test_intrusive_list_equality(list1, std::list<int>());
+
+    // Objects are unlinked when the list is destroyed
+    {
+        connection_list list6;
+        list6.splice(list6.end(), list2);
+    }
+
+    for (const Connection& connection : connections)
+    {
+        CHECK_FALSE(connection.hook.is_linked());
+    }
+}
+
+TEST_CASE("[intrusive_list] operations")
+{
+    std::mt19937 generator(23);
+
+    std::vector<Connection> connections;
+    std::list<int> list2;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const int value = generator() % 100;
+        connections.emplace_back(value);
+        list2.push_back(value);
+    }
+
+    connection_list list1(connections.begin(), connections.end());
+
+    list1.sort([](const Connection& l, const Connection& r) { return l.id > r.id; });
+    list2.sort(std::greater<int>());
+    test_intrusive_list_equality(list1, list2);
+
+    list1.sort();
+    list2.sort();
+    test_intrusive_list_equality(list1, list2);
+
+    // Sort is stable, objects with equal keys keep their order
+    const Connection* previous = nullptr;
+    for (const Connection& connection : list1)
+    {
+        if (previous && previous->id == connection.id)
+        {
+            CHECK_LT(previous, &connection);
+        }
+        previous = &connection;
+    }
+
+    std::vector<Connection> others = { 5, 50, 500 };
+    connection_list list3(others.begin(), others.end());
+    std::list<int> list4 = { 5, 50, 500 };
+    list1.merge(list3);
+    list2.merge(list4);
+    test_intrusive_list_equality(list1, list2);
+    CHECK(list3.empty());
+
+    list1.unique();
+    list2.unique();
+    test_intrusive_list_equality(list1, list2);
+
+    list1.reverse();
+    list2.reverse();
+    test_intrusive_list_equality(list1, list2);
+
+    CHECK_EQ(list1.remove([](const Connection& connection) { return connection.id % 2 == 0; }), 51);
+    list2.remove_if([](int value) { return value % 2 == 0; });
+    test_intrusive_list_equality(list1, list2);
+
+    list1.clear();
+}
+
+TEST_CASE("[intrusive_list] sort throwing comparator")
+{
+    std::vector<Connection> connections;
+    for (int i = 0; i < 100; ++i)
+    {
+        connections.emplace_back((i * 37) % 101);
+    }
+
+    connection_list list1(connections.begin(), connections.end());
+
+    int calls = 0;
+    auto comp = [&calls](const Connection& l, const Connection& r)
+    {
+        if (++calls == 150)
+        {
+            throw std::runtime_error("comparison failed");
+        }
+        return l < r;
+    };
+
+    CHECK_THROWS_AS(list1.sort(comp), std::runtime_error);
+
+    // No object is lost and the list is still consistent
+    CHECK_EQ(list1.size(), 100);
+    CHECK_EQ(std::distance(list1.begin(), list1.end()), 100);
+    CHECK_EQ(std::distance(list1.rbegin(), list1.rend()), 100);
+
+    list1.sort();
+    CHECK(std::is_sorted(list1.begin(), list1.end()));
+    CHECK_EQ(list1.front().id, 0);
+    CHECK_EQ(list1.back().id, 100);
+
+    list1.clear();
+}
+
+TEST_CASE("[intrusive_list] object with virtual functions")
+{
+    // Hooks work also in objects, which are not standard-layout
+    struct Task
+    {
+        explicit Task( int value ) : id(value) { }
+        virtual ~Task() = default;
+        virtual int priority() const { return id; }
+
+        int id = 0;
+        course_l01::intrusive_list_hook readyHook;
+        course_l01::intrusive_list_hook allHook;
+    };
+
+    std::vector<Task> tasks = { Task(1), Task(2), Task(3) };
+    course_l01::intrusive_list<Task, &Task::readyHook> ready;
+    course_l01::intrusive_list<Task, &Task::allHook> all(tasks.begin(), tasks.end());
+
+    ready.push_back(tasks[2]);
+    ready.push_front(tasks[0]);
+
+    CHECK_EQ(&ready.front(), &tasks[0]);
+    CHECK_EQ(ready.back().priority(), 3);
+    CHECK_EQ(&all.back(), &tasks[2]);
+    CHECK_EQ(std::next(all.begin())->priority(), 2);
+
+    ready.clear();
+    all.clear();
+}
+
+TEST_SUITE_END();
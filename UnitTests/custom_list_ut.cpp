@@ -21,6 +21,12 @@
 #include "doctest.h"
 
 #include <list>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <atomic>
+#include <string>
 
 template<typename T1, typename T2>
 void test_iterator_equality(T1 it1, T1 it1End, T2 it2, T2 it2End)
@@ -33,7 +39,8 @@ void test_iterator_equality(T1 it1, T1 it1End, T2 it2, T2 it2End)
     }
 }
 
-void test_list_equality(const course_l01::list<int>& v1, const std::list<int>& v2)
+template<typename Allocator>
+void test_list_equality(const course_l01::list<int, Allocator>& v1, const std::list<int>& v2)
 {
     CHECK_EQ(v1.empty(), v2.empty());
     CHECK_EQ(v1.size(), v2.size());
@@ -480,6 +487,43 @@ TEST_CASE("[list] emlace/emplace_back")
     test_list_equality(list3, list4);
 }
 
+TEST_CASE("[list] emplace in place")
+{
+    struct Message
+    {
+        Message( int messageId, std::string messageText ) : id(messageId), text(std::move(messageText)) { }
+        Message( const Message& ) = delete;
+        Message( Message&& ) = delete;
+
+        int id = 0;
+        std::string text;
+        double payload[16] = { };
+    };
+
+    // Non-movable type is constructed directly inside the node
+    course_l01::list<Message> list1;
+    list1.emplace_back(2, "second");
+    list1.emplace_front(1, "first");
+    list1.emplace(list1.end(), 3, std::string(3, 'x'));
+
+    CHECK_EQ(list1.size(), 3);
+    CHECK_EQ(list1.front().id, 1);
+    CHECK_EQ(list1.front().text, "first");
+    CHECK_EQ(std::next(list1.begin())->text, "second");
+    CHECK_EQ(list1.back().text, "xxx");
+
+    // No arguments mean value initialization
+    course_l01::list<int> list2;
+    CHECK_EQ(list2.emplace_back(), 0);
+    CHECK_EQ(list2.emplace_front(5), 5);
+    CHECK_EQ(*list2.emplace(list2.end()), 0);
+    CHECK_EQ(list2.size(), 3);
+
+    course_l01::list<std::pair<int, std::string>> list3;
+    list3.emplace_back(4, "four");
+    CHECK_EQ(list3.back().second, "four");
+}
+
 TEST_CASE("[list] merge")
 {
     course_l01::list<int> list1 = { 2, 6, 7, 10 };
@@ -585,6 +629,62 @@ TEST_CASE("[list] splice6")
     test_list_equality(list2, list4);
 }
 
+TEST_CASE("[list] splice7")
+{
+    course_l01::list<int> list1 = { 2, 6, 7, 10 };
+    course_l01::list<int> list2 = { 1, 3, 5, 9, };
+    std::list<int> list3 = { 2, 6, 7, 10 };
+    std::list<int> list4 = { 1, 3, 5, 9, };
+
+    // Iterators remain valid and refer to the same items after splice
+    auto it = std::next(list2.begin());
+    list1.splice(std::next(list1.begin()), list2, list2.begin(), std::prev(list2.end()));
+    list3.splice(std::next(list3.begin()), list4, list4.begin(), std::prev(list4.end()));
+    CHECK_EQ(*it, 3);
+    CHECK_EQ(&*it, &*std::next(list1.begin(), 2));
+
+    test_list_equality(list1, list3);
+    test_list_equality(list2, list4);
+
+    // Splice within the same list
+    list1.splice(list1.begin(), list1, std::prev(list1.end(), 3), list1.end());
+    list3.splice(list3.begin(), list3, std::prev(list3.end(), 3), list3.end());
+    test_list_equality(list1, list3);
+
+    list1.splice(list1.end(), list1, list1.begin());
+    list3.splice(list3.end(), list3, list3.begin());
+    test_list_equality(list1, list3);
+
+    list1.splice(list1.end(), list2);
+    list3.splice(list3.end(), list4);
+    test_list_equality(list1, list3);
+    test_list_equality(list2, list4);
+}
+
+TEST_CASE("[list] merge comparator")
+{
+    course_l01::list<int> list1 = { 10, 7, 6, 2 };
+    course_l01::list<int> list2 = { 12, 11, 9, 5, 3, 1, 0 };
+    std::list<int> list3 = { 10, 7, 6, 2 };
+    std::list<int> list4 = { 12, 11, 9, 5, 3, 1, 0 };
+
+    list1.merge(list2, std::greater<int>());
+    list3.merge(list4, std::greater<int>());
+
+    test_list_equality(list1, list3);
+    test_list_equality(list2, list4);
+
+    // Merge is stable, items from this list precede equal items
+    course_l01::list<std::pair<int, int>> list5 = { { 1, 0 }, { 2, 0 }, { 3, 0 } };
+    course_l01::list<std::pair<int, int>> list6 = { { 0, 1 }, { 1, 1 }, { 3, 1 }, { 4, 1 } };
+    list5.merge(list6, [](const auto& l, const auto& r) { return l.first < r.first; });
+
+    std::vector<std::pair<int, int>> expected = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 2, 0 }, { 3, 0 }, { 3, 1 }, { 4, 1 } };
+    CHECK(std::equal(list5.begin(), list5.end(), expected.begin(), expected.end()));
+    CHECK_EQ(list5.size(), expected.size());
+    CHECK(list6.empty());
+}
+
 TEST_CASE("[list] remove")
 {
     course_l01::list<int> list1 = { 2, 6, 7, 10 };
@@ -657,4 +757,278 @@ TEST_CASE("[list] sort")
     test_list_equality(list1, list2);
 }
 
+TEST_CASE("[list] sort comparator")
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 100);
+
+    for (size_t count : { 0, 1, 2, 3, 17, 1000, 4097 })
+    {
+        course_l01::list<int> list1;
+        std::list<int> list2;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const int value = distribution(generator);
+            list1.push_back(value);
+            list2.push_back(value);
+        }
+
+        list1.sort(std::greater<int>());
+        list2.sort(std::greater<int>());
+        test_list_equality(list1, list2);
+
+        // Sorted and reverse sorted runs
+        list1.sort();
+        list2.sort();
+        test_list_equality(list1, list2);
+
+        list1.sort(std::greater<int>());
+        list2.sort(std::greater<int>());
+        test_list_equality(list1, list2);
+    }
+}
+
+TEST_CASE("[list] sort stability")
+{
+    course_l01::list<std::pair<int, int>> list1;
+    std::list<std::pair<int, int>> list2;
+
+    for (int i = 0; i < 500; ++i)
+    {
+        list1.emplace_back(std::make_pair((i * 7) % 13, i));
+        list2.emplace_back((i * 7) % 13, i);
+    }
+
+    // Descending runs of equal keys must not be reversed
+    for (int i = 0; i < 10; ++i)
+    {
+        list1.push_back(std::make_pair(5 - i / 3, 1000 + i));
+        list2.push_back(std::make_pair(5 - i / 3, 1000 + i));
+    }
+
+    auto comp = [](const auto& l, const auto& r) { return l.first < r.first; };
+    list1.sort(comp);
+    list2.sort(comp);
+
+    CHECK_EQ(list1.size(), list2.size());
+    CHECK(std::equal(list1.begin(), list1.end(), list2.begin(), list2.end()));
+    CHECK(std::equal(list1.rbegin(), list1.rend(), list2.rbegin(), list2.rend()));
+}
+
+TEST_CASE("[list] sort throwing comparator")
+{
+    course_l01::list<int> list1;
+    for (int i = 0; i < 100; ++i)
+    {
+        list1.push_back((i * 37) % 101);
+    }
+
+    int calls = 0;
+    auto comp = [&calls](int l, int r)
+    {
+        if (++calls == 150)
+        {
+            throw std::runtime_error("comparison failed");
+        }
+        return l < r;
+    };
+
+    CHECK_THROWS_AS(list1.sort(comp), std::runtime_error);
+
+    // No item is lost and the list is still consistent
+    CHECK_EQ(list1.size(), 100);
+    CHECK_EQ(std::distance(list1.begin(), list1.end()), 100);
+    CHECK_EQ(std::distance(list1.rbegin(), list1.rend()), 100);
+
+    list1.sort();
+    CHECK(std::is_sorted(list1.begin(), list1.end()));
+    CHECK_EQ(list1.front(), 0);
+    CHECK_EQ(list1.back(), 100);
+}
+
+TEST_CASE("[list] parallel sort")
+{
+    std::mt19937 generator(7);
+
+    for (size_t threadCount : { 1, 2, 3, 4, 7 })
+    {
+        course_l01::list<std::pair<int, int>> list1;
+        std::vector<std::pair<int, int>> list2;
+
+        for (int i = 0; i < 100000; ++i)
+        {
+            const int key = int(generator() % 1000);
+            list1.emplace_back(key, i);
+            list2.emplace_back(key, i);
+        }
+
+        std::vector<const std::pair<int, int>*> addresses;
+        for (const auto& item : list1)
+        {
+            addresses.push_back(&item);
+        }
+
+        auto comp = [](const auto& l, const auto& r) { return l.first < r.first; };
+        list1.parallel_sort(comp, threadCount);
+        std::stable_sort(list2.begin(), list2.end(), comp);
+
+        CHECK_EQ(list1.size(), list2.size());
+        CHECK(std::equal(list1.begin(), list1.end(), list2.begin(), list2.end()));
+        CHECK(std::equal(list1.rbegin(), list1.rend(), list2.rbegin(), list2.rend()));
+
+        // Values stay in their nodes, only the nodes are relinked
+        for (const auto& item : list1)
+        {
+            CHECK_EQ(addresses[item.second], &item);
+        }
+    }
+
+    course_l01::list<int> list3 = { 3, 1, 2 };
+    list3.parallel_sort();
+    CHECK(std::is_sorted(list3.begin(), list3.end()));
+}
+
+TEST_CASE("[list] parallel sort throwing comparator")
+{
+    course_l01::list<int> list1;
+    for (int i = 0; i < 100000; ++i)
+    {
+        list1.push_back((i * 37) % 100003);
+    }
+
+    const std::vector<int> values(list1.begin(), list1.end());
+
+    std::atomic<int> calls = 0;
+    auto comp = [&calls](int l, int r)
+    {
+        if (++calls == 500000)
+        {
+            throw std::runtime_error("comparison failed");
+        }
+        return l < r;
+    };
+
+    CHECK_THROWS_AS(list1.parallel_sort(comp, 4), std::runtime_error);
+
+    // List is left unchanged
+    CHECK_EQ(list1.size(), values.size());
+    CHECK(std::equal(list1.begin(), list1.end(), values.begin(), values.end()));
+    CHECK(std::equal(list1.rbegin(), list1.rend(), values.rbegin(), values.rend()));
+}
+
+TEST_CASE("[list] sentinel")
+{
+    static_assert(sizeof(course_l01::list<int>::iterator) == sizeof(void*));
+
+    course_l01::list<int> list1 = { 1, 2, 3 };
+    std::list<int> list2 = { 1, 2, 3 };
+    CHECK_EQ(*std::prev(list1.end()), 3);
+    CHECK_EQ(std::next(list1.end()), list1.begin());
+
+    // Nodes moved to the other list are linked to its sentinel
+    auto it = list1.begin();
+    course_l01::list<int> list3(std::move(list1));
+    CHECK(list1.empty());
+    CHECK_EQ(list1.begin(), list1.end());
+    CHECK_EQ(it, list3.begin());
+    test_list_equality(list3, list2);
+
+    list1.swap(list3);
+    test_list_equality(list1, list2);
+    test_list_equality(list3, std::list<int>());
+
+    list3 = std::move(list1);
+    list3.push_front(0);
+    list2.push_front(0);
+    test_list_equality(list3, list2);
+    CHECK_EQ(*std::prev(list3.end()), 3);
+}
+
+TEST_CASE("[list] pooled nodes")
+{
+    course_l01::pooled_list<int> list1 = { 1, 2, 3, 4, 5 };
+    std::list<int> list2 = { 1, 2, 3, 4, 5 };
+    test_list_equality(list1, list2);
+
+    // Released node is recycled by the next allocation
+    const int* address = &list1.front();
+    list1.pop_front();
+    list2.pop_front();
+    list1.push_back(6);
+    list2.push_back(6);
+    CHECK_EQ(&list1.back(), address);
+    test_list_equality(list1, list2);
+
+    // Lists sharing the pool resource can exchange nodes
+    course_l01::pooled_list<int> list3(list1.get_allocator());
+    list3.splice(list3.end(), list1);
+    list1 = list3;
+    list3.sort();
+    list2.sort();
+    test_list_equality(list3, list2);
+    CHECK(list1.get_allocator() == list3.get_allocator());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        list3.push_back(i);
+        list2.push_back(i);
+    }
+
+    list3.remove([](int value) { return value % 3 == 0; });
+    list2.remove_if([](int value) { return value % 3 == 0; });
+    test_list_equality(list3, list2);
+
+    course_l01::pooled_list<int> list4;
+    list4 = std::move(list3);
+    test_list_equality(list4, list2);
+}
+
+TEST_CASE("[list] splice between pooled lists")
+{
+    // Default pooled lists share the default pool resource
+    course_l01::pooled_list<int> list1;
+    {
+        course_l01::pooled_list<int> list2 = { 1, 2, 3 };
+        CHECK(list1.get_allocator() == list2.get_allocator());
+        list1.splice(list1.end(), list2);
+    }
+    test_list_equality(list1, std::list<int>{ 1, 2, 3 });
+
+    // Lists with different pool resources move the items instead of relinking
+    course_l01::pool_allocator<int> allocator(std::make_shared<course_l01::pool_resource>());
+    {
+        course_l01::pooled_list<int> list2({ 0, 4, 5, 6 }, allocator);
+        CHECK(list1.get_allocator() != list2.get_allocator());
+        list1.splice(list1.end(), list2, std::next(list2.begin()));
+        list1.splice(list1.end(), list2, std::next(list2.begin()), list2.end());
+        list1.merge(list2);
+        CHECK(list2.empty());
+
+        course_l01::pooled_list<int> list3({ 7, 8 }, allocator);
+        list1.splice(list1.end(), list3);
+        CHECK(list3.empty());
+    }
+    test_list_equality(list1, std::list<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8 });
+}
+
+TEST_CASE("[list] node pool")
+{
+    course_l01::node_pool pool(24, 8, 4);
+
+    void* block1 = pool.allocate();
+    void* block2 = pool.allocate();
+    CHECK_EQ(static_cast<unsigned char*>(block2) - static_cast<unsigned char*>(block1), 24);
+    CHECK_EQ(pool.slab_count(), 1);
+
+    pool.deallocate(block1);
+    CHECK_EQ(pool.allocate(), block1);
+
+    pool.allocate();
+    pool.allocate();
+    CHECK_EQ(pool.slab_count(), 1);
+    pool.allocate();
+    CHECK_EQ(pool.slab_count(), 2);
+}
+
 TEST_SUITE_END();
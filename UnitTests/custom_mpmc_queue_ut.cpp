@@ -0,0 +1,222 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+
+#include "custom_mpmc_queue.h"
+#include "doctest.h"
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <numeric>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+
+struct ThrowingCopy
+{
+    ThrowingCopy( int value ) : value(value) { }
+    ThrowingCopy( const ThrowingCopy& other ) : value(other.value) { if (value < 0) throw std::runtime_error("copy failed"); }
+    ThrowingCopy( ThrowingCopy&& ) noexcept = default;
+    ThrowingCopy& operator=( ThrowingCopy&& ) noexcept = default;
+
+    int value = 0;
+};
+
+}   // namespace
+
+TEST_SUITE_BEGIN("mpmc_queue");
+
+TEST_CASE("[mpmc_queue] single thread")
+{
+    course_l01::mpmc_queue<std::string> queue(3);
+    CHECK_EQ(queue.capacity(), 4);
+    CHECK(queue.empty());
+
+    CHECK(queue.try_push("a"));
+    CHECK(queue.try_push(std::string("b")));
+    CHECK(queue.try_emplace(2, 'c'));
+    queue.push("d");
+    CHECK_FALSE(queue.try_push("e"));
+    CHECK_EQ(queue.size(), 4);
+
+    std::string value;
+    CHECK(queue.try_pop(value));
+    CHECK_EQ(value, "a");
+    queue.pop(value);
+    CHECK_EQ(value, "b");
+
+    // Positions wrap around the buffer
+    queue.emplace("e");
+    queue.push("f");
+
+    std::vector<std::string> values;
+    while (queue.try_pop(value))
+    {
+        values.push_back(value);
+    }
+
+    CHECK_EQ(values, std::vector<std::string>{ "cc", "d", "e", "f" });
+    CHECK(queue.empty());
+
+    // Items left in the queue are destroyed with it
+    course_l01::mpmc_queue<std::string> queue2(2);
+    queue2.push(std::string(100, 'x'));
+}
+
+TEST_CASE("[mpmc_queue] bulk operations")
+{
+    course_l01::mpmc_queue<int> queue(16);
+    std::vector<int> input(40);
+    std::iota(input.begin(), input.end(), 0);
+
+    CHECK_EQ(queue.try_push_n(input.begin(), 10), 10);
+    CHECK_EQ(queue.try_push_n(input.begin() + 10, 10), 6);
+    CHECK_EQ(queue.try_push_n(input.begin() + 16, 10), 0);
+
+    std::vector<int> output;
+    CHECK_EQ(queue.try_pop_n(std::back_inserter(output), 4), 4);
+    CHECK_EQ(queue.try_push_n(input.begin() + 16, 10), 4);
+    CHECK_EQ(queue.try_pop_n(std::back_inserter(output), 40), 16);
+    CHECK_EQ(queue.try_pop_n(std::back_inserter(output), 40), 0);
+    CHECK(queue.empty());
+
+    CHECK(std::equal(output.begin(), output.end(), input.begin(), input.begin() + 20));
+
+    // Empty batches do nothing, both on empty and non-empty queue
+    CHECK_EQ(queue.try_pop_n(std::back_inserter(output), 0), 0);
+    CHECK_EQ(queue.try_push_n(input.begin(), 0), 0);
+    queue.push(1);
+    CHECK_EQ(queue.try_pop_n(std::back_inserter(output), 0), 0);
+    CHECK_EQ(queue.try_push_n(input.begin(), 0), 0);
+    CHECK_EQ(queue.size(), 1);
+}
+
+TEST_CASE("[mpmc_queue] throwing copy")
+{
+    course_l01::mpmc_queue<ThrowingCopy> queue(4);
+    const ThrowingCopy good(1);
+    const ThrowingCopy bad(-1);
+
+    CHECK(queue.try_push(good));
+    CHECK_THROWS_AS(queue.try_push(bad), std::runtime_error);
+    CHECK_THROWS_AS(queue.push(bad), std::runtime_error);
+    CHECK(queue.try_push(ThrowingCopy(2)));
+    CHECK_EQ(queue.size(), 2);
+
+    ThrowingCopy value(0);
+    CHECK(queue.try_pop(value));
+    CHECK_EQ(value.value, 1);
+    CHECK(queue.try_pop(value));
+    CHECK_EQ(value.value, 2);
+    CHECK_FALSE(queue.try_pop(value));
+}
+
+TEST_CASE("[mpmc_queue] producer and consumer threads")
+{
+    constexpr int threadCount = 4;
+    constexpr int itemsPerThread = 50000;
+    course_l01::mpmc_queue<int> queue(128);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        producers.emplace_back([&queue, t]()
+        {
+            // Item encodes the producer and its sequence number
+            for (int i = 0; i < itemsPerThread;)
+            {
+                if (i % 2 == 0)
+                {
+                    queue.push(t * itemsPerThread + i++);
+                    continue;
+                }
+
+                int batch[8];
+                const int batchSize = std::min(8, itemsPerThread - i);
+                std::iota(batch, batch + batchSize, t * itemsPerThread + i);
+                const int pushed = int(queue.try_push_n(batch, batchSize));
+                i += pushed;
+
+                if (pushed == 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<std::vector<int>> received(threadCount);
+    std::vector<std::thread> consumers;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        consumers.emplace_back([&queue, &values = received[t], t]()
+        {
+            while (values.size() < size_t(itemsPerThread))
+            {
+                if (t % 2 == 0)
+                {
+                    int value = 0;
+                    queue.pop(value);
+                    values.push_back(value);
+                }
+                else
+                {
+                    const size_t wanted = std::min<size_t>(8, itemsPerThread - values.size());
+                    if (queue.try_pop_n(std::back_inserter(values), wanted) == 0)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : producers)
+    {
+        thread.join();
+    }
+
+    for (std::thread& thread : consumers)
+    {
+        thread.join();
+    }
+
+    // Every item is received once, items of one producer in order
+    std::vector<int> counts(threadCount * itemsPerThread, 0);
+    for (const std::vector<int>& values : received)
+    {
+        std::vector<int> last(threadCount, -1);
+
+        for (int value : values)
+        {
+            ++counts[value];
+            CHECK_GT(value, last[value / itemsPerThread]);
+            last[value / itemsPerThread] = value;
+        }
+    }
+
+    CHECK(std::all_of(counts.begin(), counts.end(), [](int count) { return count == 1; }));
+    CHECK(queue.empty());
+}
+
+TEST_SUITE_END();
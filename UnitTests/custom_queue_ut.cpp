@@ -19,6 +19,8 @@
 
 #include "doctest.h"
 #include "custom_queue.h"
+#include "custom_forward_list.h"
+#include "custom_list.h"
 
 #include <queue>
 
@@ -119,3 +121,77 @@ TEST_CASE("[queue] swap queues")
 
     test_queue_equality(queue3, queue4);
 }
+
+TEST_CASE("[queue] forward list container")
+{
+    course_l01::queue<int, course_l01::forward_list<int>> queue1;
+    std::queue<int> queue2;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        queue1.push(i + 1);
+        queue2.push(i + 1);
+        queue1.emplace(i + 10);
+        queue2.emplace(i + 10);
+
+        CHECK_EQ(queue1.size(), queue2.size());
+        CHECK_EQ(queue1.front(), queue2.front());
+        CHECK_EQ(queue1.back(), queue2.back());
+    }
+
+    course_l01::queue<int, course_l01::forward_list<int>> queue3;
+    queue3.swap(queue1);
+    CHECK(queue1.empty());
+
+    while (!queue3.empty())
+    {
+        CHECK_EQ(queue3.front(), queue2.front());
+        queue3.pop();
+        queue2.pop();
+    }
+
+    CHECK(queue2.empty());
+}
+
+TEST_CASE("[queue] list container")
+{
+    course_l01::queue<int, course_l01::list<int>> queue1;
+    std::queue<int> queue2;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        queue1.push(i);
+        queue2.push(i);
+
+        if (i % 3 == 2)
+        {
+            queue1.pop();
+            queue2.pop();
+        }
+
+        CHECK_EQ(queue1.size(), queue2.size());
+        CHECK_EQ(queue1.front(), queue2.front());
+        CHECK_EQ(queue1.back(), queue2.back());
+    }
+}
+
+TEST_CASE("[queue] wrap around")
+{
+    // Queue keeps a few items, so the ring buffer wraps around many times
+    course_l01::queue<int> queue1;
+    std::queue<int> queue2;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        queue1.push(i);
+        queue2.push(i);
+
+        if (i % 10 != 9)
+        {
+            queue1.pop();
+            queue2.pop();
+        }
+
+        test_queue_equality(queue1, queue2);
+    }
+}
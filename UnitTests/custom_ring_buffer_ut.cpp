@@ -0,0 +1,188 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+
+#include "custom_ring_buffer.h"
+#include "doctest.h"
+
+#include <deque>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+
+template<typename T>
+void test_ring_buffer_equality(const course_l01::ring_buffer<T>& v1, const std::deque<T>& v2)
+{
+    CHECK_EQ(v1.empty(), v2.empty());
+    CHECK_EQ(v1.size(), v2.size());
+    CHECK_EQ(std::distance(v1.begin(), v1.end()), std::distance(v2.begin(), v2.end()));
+    CHECK(std::equal(v1.begin(), v1.end(), v2.begin(), v2.end()));
+    CHECK(std::equal(v1.rbegin(), v1.rend(), v2.rbegin(), v2.rend()));
+
+    for (size_t i = 0; i < v2.size(); ++i)
+    {
+        CHECK_EQ(v1[i], v2[i]);
+    }
+
+    // Capacity is always a power of two
+    CHECK_EQ(v1.capacity() & (v1.capacity() - 1), 0);
+}
+
+}   // namespace
+
+TEST_SUITE_BEGIN("ring_buffer");
+
+TEST_CASE("[ring_buffer] constructors and assignment")
+{
+    course_l01::ring_buffer<std::string> buffer1;
+    course_l01::ring_buffer<std::string> buffer2(3);
+    course_l01::ring_buffer<std::string> buffer3 = { "a", "b", "c", "d" };
+
+    test_ring_buffer_equality(buffer1, {});
+    test_ring_buffer_equality(buffer2, { "", "", "" });
+    test_ring_buffer_equality(buffer3, { "a", "b", "c", "d" });
+
+    // Copy of a wrapped buffer keeps the order of items
+    buffer3.pop_front();
+    buffer3.pop_front();
+    buffer3.push_front("x");
+    buffer3.push_back("y");
+    course_l01::ring_buffer<std::string> buffer4(buffer3);
+    test_ring_buffer_equality(buffer4, { "x", "c", "d", "y" });
+
+    course_l01::ring_buffer<std::string> buffer5(std::move(buffer4));
+    test_ring_buffer_equality(buffer4, {});
+    test_ring_buffer_equality(buffer5, { "x", "c", "d", "y" });
+
+    buffer1 = buffer5;
+    test_ring_buffer_equality(buffer1, { "x", "c", "d", "y" });
+    buffer2 = std::move(buffer5);
+    test_ring_buffer_equality(buffer2, { "x", "c", "d", "y" });
+
+    buffer1.swap(buffer3);
+    test_ring_buffer_equality(buffer3, { "x", "c", "d", "y" });
+
+    buffer1.assign(2, "z");
+    test_ring_buffer_equality(buffer1, { "z", "z" });
+    buffer1.assign({ "p", "q" });
+    test_ring_buffer_equality(buffer1, { "p", "q" });
+    CHECK_EQ(buffer1.at(1), "q");
+    CHECK_THROWS_AS(buffer1.at(2), std::out_of_range);
+}
+
+TEST_CASE("[ring_buffer] push and pop at both ends")
+{
+    course_l01::ring_buffer<int> buffer1;
+    std::deque<int> buffer2;
+
+    std::mt19937 generator(3);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        switch (generator() % 5)
+        {
+            case 0:
+                buffer1.push_back(i);
+                buffer2.push_back(i);
+                break;
+
+            case 1:
+                buffer1.emplace_front(i);
+                buffer2.emplace_front(i);
+                break;
+
+            case 2:
+                if (!buffer2.empty())
+                {
+                    buffer1.pop_front();
+                    buffer2.pop_front();
+                }
+                break;
+
+            case 3:
+                if (!buffer2.empty())
+                {
+                    buffer1.pop_back();
+                    buffer2.pop_back();
+                }
+                break;
+
+            case 4:
+                buffer1.push_back(i);
+                buffer2.push_back(i);
+                buffer1.push_front(-i);
+                buffer2.push_front(-i);
+                break;
+        }
+
+        REQUIRE_EQ(buffer1.size(), buffer2.size());
+        if (!buffer2.empty())
+        {
+            REQUIRE_EQ(buffer1.front(), buffer2.front());
+            REQUIRE_EQ(buffer1.back(), buffer2.back());
+        }
+    }
+
+    test_ring_buffer_equality(buffer1, buffer2);
+
+    // Random access iterators work with standard algorithms
+    std::sort(buffer1.begin(), buffer1.end());
+    std::sort(buffer2.begin(), buffer2.end());
+    test_ring_buffer_equality(buffer1, buffer2);
+    CHECK_EQ(*std::lower_bound(buffer1.begin(), buffer1.end(), buffer2[10]), buffer2[10]);
+
+    buffer1.resize(10);
+    buffer2.resize(10);
+    test_ring_buffer_equality(buffer1, buffer2);
+
+    buffer1.shrink_to_fit();
+    CHECK_EQ(buffer1.capacity(), 16);
+    test_ring_buffer_equality(buffer1, buffer2);
+
+    buffer1.clear();
+    buffer1.shrink_to_fit();
+    CHECK_EQ(buffer1.capacity(), 0);
+}
+
+TEST_CASE("[ring_buffer] push own item while growing")
+{
+    course_l01::ring_buffer<std::string> buffer1;
+    buffer1.reserve(8);
+    CHECK_EQ(buffer1.capacity(), 8);
+
+    for (int i = 0; i < 8; ++i)
+    {
+        buffer1.push_back(std::string(32, char('a' + i)));
+    }
+
+    // Buffer is full, so it reallocates while the argument refers to it
+    buffer1.push_back(buffer1.front());
+    buffer1.push_front(buffer1.back());
+    CHECK_EQ(buffer1.capacity(), 16);
+    CHECK_EQ(buffer1.size(), 10);
+    CHECK_EQ(buffer1.front(), std::string(32, 'a'));
+    CHECK_EQ(buffer1.back(), std::string(32, 'a'));
+    CHECK_EQ(buffer1[8], std::string(32, 'h'));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,210 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+
+#include "custom_segmented_vector.h"
+#include "doctest.h"
+
+#include <vector>
+#include <string>
+#include <map>
+
+template<typename T, std::size_t BlockShift>
+void test_segmented_vector_equality(const course_l01::segmented_vector<T, BlockShift>& v1, const std::vector<T>& v2)
+{
+    CHECK_EQ(v1.empty(), v2.empty());
+    CHECK_EQ(v1.size(), v2.size());
+    CHECK_GE(v1.capacity(), v1.size());
+    CHECK_EQ(std::distance(v1.begin(), v1.end()), std::distance(v2.begin(), v2.end()));
+
+    for (size_t i = 0; i < std::min(v1.size(), v2.size()); ++i)
+    {
+        CHECK_EQ(v1[i], v2[i]);
+        CHECK_EQ(v1.at(i), v2.at(i));
+    }
+
+    CHECK(std::equal(v1.begin(), v1.end(), v2.begin(), v2.end()));
+    CHECK(std::equal(v1.cbegin(), v1.cend(), v2.cbegin(), v2.cend()));
+    CHECK(std::equal(v1.rbegin(), v1.rend(), v2.rbegin(), v2.rend()));
+}
+
+// Allocator, which remembers the owner of each allocated block,
+// so we can check memory is released by the allocator which allocated it.
+template<typename T>
+class OwnerCheckingAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    OwnerCheckingAllocator(int id = 0) : m_id(id) { }
+    template<typename U>
+    OwnerCheckingAllocator(const OwnerCheckingAllocator<U>& other) : m_id(other.get_id()) { }
+
+    T* allocate(std::size_t n)
+    {
+        T* p = std::allocator<T>().allocate(n);
+        owners()[p] = m_id;
+        return p;
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        CHECK_EQ(owners()[p], m_id);
+        owners().erase(p);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    int get_id() const { return m_id; }
+
+    bool operator==(const OwnerCheckingAllocator& other) const { return m_id == other.m_id; }
+    bool operator!=(const OwnerCheckingAllocator& other) const { return m_id != other.m_id; }
+
+    static std::map<const void*, int>& owners()
+    {
+        static std::map<const void*, int> s_owners;
+        return s_owners;
+    }
+
+private:
+    int m_id = 0;
+};
+
+TEST_SUITE_BEGIN("segmented_vector");
+
+TEST_CASE("[segmented_vector] constructors")
+{
+    std::vector<int> vector2 = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+    course_l01::segmented_vector<int, 2> vector1(vector2.begin(), vector2.end());
+    test_segmented_vector_equality(vector1, vector2);
+    CHECK_EQ(vector1.capacity(), 12);
+
+    course_l01::segmented_vector<int, 2> vector3(vector1);
+    test_segmented_vector_equality(vector3, vector2);
+
+    course_l01::segmented_vector<int, 2> vector4(std::move(vector1));
+    test_segmented_vector_equality(vector4, vector2);
+    CHECK(vector1.empty());
+
+    course_l01::segmented_vector<int, 2> vector5 = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    test_segmented_vector_equality(vector5, vector2);
+
+    course_l01::segmented_vector<int, 2> vector6(7);
+    test_segmented_vector_equality(vector6, std::vector<int>(7));
+
+    vector6 = vector5;
+    test_segmented_vector_equality(vector6, vector2);
+
+    vector6 = course_l01::segmented_vector<int, 2>({ 1, 2 });
+    test_segmented_vector_equality(vector6, std::vector<int>{ 1, 2 });
+}
+
+TEST_CASE("[segmented_vector] references are stable")
+{
+    course_l01::segmented_vector<std::string, 3> vector1;
+    std::vector<std::string> vector2;
+
+    vector1.push_back("first");
+    vector2.push_back("first");
+    const std::string* first = &vector1.front();
+
+    for (int i = 0; i < 100; ++i)
+    {
+        vector1.emplace_back(std::to_string(i));
+        vector2.emplace_back(std::to_string(i));
+    }
+
+    CHECK_EQ(&vector1.front(), first);
+    CHECK_EQ(*first, "first");
+    test_segmented_vector_equality(vector1, vector2);
+}
+
+TEST_CASE("[segmented_vector] resize/pop_back/clear/shrink_to_fit")
+{
+    course_l01::segmented_vector<int, 2> vector1;
+    std::vector<int> vector2;
+
+    vector1.resize(10, 5);
+    vector2.resize(10, 5);
+    test_segmented_vector_equality(vector1, vector2);
+
+    vector1.resize(3);
+    vector2.resize(3);
+    test_segmented_vector_equality(vector1, vector2);
+    CHECK_EQ(vector1.capacity(), 12);
+
+    vector1.shrink_to_fit();
+    CHECK_EQ(vector1.capacity(), 4);
+
+    vector1.pop_back();
+    vector2.pop_back();
+    test_segmented_vector_equality(vector1, vector2);
+
+    vector1.reserve(20);
+    CHECK_GE(vector1.capacity(), 20);
+    test_segmented_vector_equality(vector1, vector2);
+
+    vector1.clear();
+    vector2.clear();
+    test_segmented_vector_equality(vector1, vector2);
+    vector1.shrink_to_fit();
+    CHECK_EQ(vector1.capacity(), 0);
+}
+
+TEST_CASE("[segmented_vector] random access iterators")
+{
+    course_l01::segmented_vector<int, 2> vector1 = { 5, 3, 9, 1, 7, 2, 8, 4, 6, 0 };
+    std::vector<int> vector2 = { 5, 3, 9, 1, 7, 2, 8, 4, 6, 0 };
+
+    std::sort(vector1.begin(), vector1.end());
+    std::sort(vector2.begin(), vector2.end());
+    test_segmented_vector_equality(vector1, vector2);
+
+    auto it = std::lower_bound(vector1.cbegin(), vector1.cend(), 6);
+    CHECK_EQ(it - vector1.cbegin(), 6);
+    CHECK_EQ(*it, 6);
+    CHECK_EQ(it[2], 8);
+    CHECK_EQ(*(it - 6), 0);
+}
+
+TEST_CASE("[segmented_vector] propagate allocator on copy assignment")
+{
+    using allocator = OwnerCheckingAllocator<std::string>;
+
+    {
+        course_l01::segmented_vector<std::string, 2, allocator> vector1({ "a", "b", "c", "d", "e" }, allocator(1));
+        course_l01::segmented_vector<std::string, 2, allocator> vector2({ "f", "g" }, allocator(2));
+
+        vector1 = vector2;
+        CHECK_EQ(vector1.get_allocator().get_id(), 2);
+        CHECK_EQ(vector1.size(), 2);
+        CHECK_EQ(vector1[0], "f");
+        CHECK_EQ(vector1[1], "g");
+
+        vector1.resize(9, "h");
+        CHECK_EQ(vector1.back(), "h");
+    }
+
+    CHECK(allocator::owners().empty());
+}
+
+TEST_SUITE_END();
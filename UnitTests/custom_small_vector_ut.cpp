@@ -0,0 +1,203 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#include "custom_small_vector.h"
+#include "doctest.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <algorithm>
+
+template<typename T, std::size_t N>
+void test_small_vector_equality(const course_l01::small_vector<T, N>& v1, const std::vector<T>& v2)
+{
+    CHECK_EQ(v1.empty(), v2.empty());
+    CHECK_EQ(v1.size(), v2.size());
+    CHECK_GE(v1.capacity(), v1.size());
+    CHECK_EQ(v1.is_inline(), v1.capacity() == N);
+
+    for (size_t i = 0; i < std::min(v1.size(), v2.size()); ++i)
+    {
+        CHECK_EQ(v1[i], v2[i]);
+        CHECK_EQ(v1.at(i), v2.at(i));
+    }
+
+    CHECK(std::equal(v1.begin(), v1.end(), v2.begin(), v2.end()));
+    CHECK(std::equal(v1.rbegin(), v1.rend(), v2.rbegin(), v2.rend()));
+}
+
+TEST_SUITE_BEGIN("small_vector");
+
+TEST_CASE("[small_vector] constructors")
+{
+    std::vector<int> vector2 = { 1, 2, 3, 4, 5 };
+
+    course_l01::small_vector<int, 8> vector1(vector2.begin(), vector2.end());
+    test_small_vector_equality(vector1, vector2);
+    CHECK(vector1.is_inline());
+
+    course_l01::small_vector<int, 8> vector3(vector1);
+    test_small_vector_equality(vector3, vector2);
+
+    course_l01::small_vector<int, 8> vector4(std::move(vector1));
+    test_small_vector_equality(vector4, vector2);
+
+    course_l01::small_vector<int, 4> vector5 = { 1, 2, 3, 4, 5 };
+    test_small_vector_equality(vector5, vector2);
+    CHECK(!vector5.is_inline());
+
+    const int* data = vector5.data();
+    course_l01::small_vector<int, 4> vector6(std::move(vector5));
+    test_small_vector_equality(vector6, vector2);
+    CHECK_EQ(vector6.data(), data);
+    CHECK(vector5.empty());
+    CHECK(vector5.is_inline());
+
+    course_l01::small_vector<int, 4> vector7(3);
+    test_small_vector_equality(vector7, std::vector<int>(3));
+}
+
+TEST_CASE("[small_vector] spill to heap and shrink back")
+{
+    course_l01::small_vector<int, 4> vector1;
+    std::vector<int> vector2;
+
+    for (int i = 0; i < 20; ++i)
+    {
+        vector1.push_back(i);
+        vector2.push_back(i);
+        test_small_vector_equality(vector1, vector2);
+    }
+
+    CHECK(!vector1.is_inline());
+
+    vector1.erase(std::next(vector1.begin(), 10), vector1.end());
+    vector2.erase(std::next(vector2.begin(), 10), vector2.end());
+    vector1.shrink_to_fit();
+    test_small_vector_equality(vector1, vector2);
+    CHECK_EQ(vector1.capacity(), 10);
+
+    vector1.resize(3);
+    vector2.resize(3);
+    vector1.shrink_to_fit();
+    test_small_vector_equality(vector1, vector2);
+    CHECK(vector1.is_inline());
+
+    vector1.reserve(100);
+    CHECK_GE(vector1.capacity(), 100);
+    test_small_vector_equality(vector1, vector2);
+}
+
+TEST_CASE("[small_vector] insert/erase/emplace")
+{
+    course_l01::small_vector<std::string, 3> vector1 = { "a", "b" };
+    std::vector<std::string> vector2 = { "a", "b" };
+
+    vector1.insert(std::next(vector1.begin()), "c");
+    vector2.insert(std::next(vector2.begin()), "c");
+    test_small_vector_equality(vector1, vector2);
+
+    vector1.insert(vector1.begin(), 3, "d");
+    vector2.insert(vector2.begin(), 3, "d");
+    test_small_vector_equality(vector1, vector2);
+
+    vector1.insert(vector1.end(), { "e", "f" });
+    vector2.insert(vector2.end(), { "e", "f" });
+    test_small_vector_equality(vector1, vector2);
+
+    vector1.emplace(std::next(vector1.begin(), 2), 3, 'g');
+    vector2.emplace(std::next(vector2.begin(), 2), 3, 'g');
+    test_small_vector_equality(vector1, vector2);
+
+    vector1.emplace_back("h");
+    vector2.emplace_back("h");
+    test_small_vector_equality(vector1, vector2);
+
+    vector1.erase(std::next(vector1.begin()), std::next(vector1.begin(), 4));
+    vector2.erase(std::next(vector2.begin()), std::next(vector2.begin(), 4));
+    test_small_vector_equality(vector1, vector2);
+
+    vector1.pop_back();
+    vector2.pop_back();
+    test_small_vector_equality(vector1, vector2);
+
+    CHECK_EQ(vector1.remove("e"), 1);
+    vector2.erase(std::remove(vector2.begin(), vector2.end(), "e"), vector2.end());
+    test_small_vector_equality(vector1, vector2);
+
+    vector1.clear();
+    vector2.clear();
+    test_small_vector_equality(vector1, vector2);
+}
+
+TEST_CASE("[small_vector] assignment and swap")
+{
+    course_l01::small_vector<std::string, 2> vector1 = { "a" };
+    course_l01::small_vector<std::string, 2> vector2 = { "b", "c", "d" };
+    std::vector<std::string> vector3 = { "a" };
+    std::vector<std::string> vector4 = { "b", "c", "d" };
+
+    vector1.swap(vector2);
+    test_small_vector_equality(vector1, vector4);
+    test_small_vector_equality(vector2, vector3);
+
+    vector1.swap(vector2);
+    test_small_vector_equality(vector1, vector3);
+    test_small_vector_equality(vector2, vector4);
+
+    vector1 = vector2;
+    test_small_vector_equality(vector1, vector4);
+
+    vector2.assign({ "e" });
+    vector1 = std::move(vector2);
+    test_small_vector_equality(vector1, std::vector<std::string>{ "e" });
+    CHECK(vector2.empty());
+
+    vector1.assign(5, "f");
+    test_small_vector_equality(vector1, std::vector<std::string>(5, "f"));
+}
+
+TEST_CASE("[small_vector] move-only items")
+{
+    static_assert(std::is_nothrow_move_constructible_v<course_l01::small_vector<std::string, 2>>);
+
+    course_l01::small_vector<std::unique_ptr<int>, 2> vector1;
+    vector1.resize(4);
+    CHECK_EQ(vector1.size(), 4);
+    CHECK(std::all_of(vector1.begin(), vector1.end(), [](const auto& item) { return item == nullptr; }));
+
+    vector1[3] = std::make_unique<int>(3);
+    vector1.resize(1);
+    CHECK_EQ(vector1.size(), 1);
+
+    // Vector of small vectors must move the items on growth, not copy them
+    std::vector<course_l01::small_vector<std::unique_ptr<int>, 2>> vector2;
+    for (int i = 0; i < 16; ++i)
+    {
+        vector2.emplace_back().push_back(std::make_unique<int>(i));
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+        CHECK_EQ(*vector2[i].front(), i);
+    }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,167 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+
+#include "custom_spsc_queue.h"
+#include "doctest.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <numeric>
+#include <atomic>
+
+TEST_SUITE_BEGIN("spsc_queue");
+
+TEST_CASE("[spsc_queue] single thread")
+{
+    course_l01::spsc_queue<std::string> queue(5);
+    CHECK_EQ(queue.capacity(), 8);
+    CHECK(queue.empty());
+
+    for (int i = 0; i < 8; ++i)
+    {
+        CHECK(queue.try_push(std::to_string(i)));
+    }
+
+    CHECK_FALSE(queue.try_push("full"));
+    CHECK_EQ(queue.size(), 8);
+    CHECK_EQ(queue.front(), "0");
+
+    queue.pop();
+    std::string value;
+    CHECK(queue.try_pop(value));
+    CHECK_EQ(value, "1");
+
+    // Indices wrap around the buffer
+    queue.push("8");
+    queue.emplace(3, 'x');
+
+    std::vector<std::string> values;
+    while (queue.try_pop(value))
+    {
+        values.push_back(value);
+    }
+
+    CHECK_EQ(values, std::vector<std::string>{ "2", "3", "4", "5", "6", "7", "8", "xxx" });
+    CHECK(queue.empty());
+
+    // Items left in the queue are destroyed with it
+    course_l01::spsc_queue<std::shared_ptr<int>> queue2(4);
+    auto pointer = std::make_shared<int>(1);
+    queue2.push(pointer);
+    queue2.push(pointer);
+    CHECK_EQ(pointer.use_count(), 3);
+    queue2.pop();
+    CHECK_EQ(pointer.use_count(), 2);
+}
+
+TEST_CASE("[spsc_queue] batches")
+{
+    course_l01::spsc_queue<int> queue(16);
+    std::vector<int> input(40);
+    std::iota(input.begin(), input.end(), 0);
+
+    CHECK_EQ(queue.try_push_n(input.begin(), 10), 10);
+    CHECK_EQ(queue.try_push_n(input.begin() + 10, 10), 6);
+    CHECK_EQ(queue.try_push_n(input.begin() + 16, 10), 0);
+
+    std::vector<int> output(40, -1);
+    CHECK_EQ(queue.try_pop_n(output.begin(), 4), 4);
+    CHECK_EQ(queue.try_push_n(input.begin() + 16, 10), 4);
+    CHECK_EQ(queue.try_pop_n(output.begin() + 4, 40), 16);
+    CHECK_EQ(queue.try_pop_n(output.begin() + 20, 40), 0);
+    CHECK(queue.empty());
+
+    CHECK(std::equal(output.begin(), output.begin() + 20, input.begin()));
+    CHECK_EQ(output[20], -1);
+}
+
+TEST_CASE("[spsc_queue] producer and consumer threads")
+{
+    constexpr int count = 200000;
+    course_l01::spsc_queue<int> queue(64);
+
+    std::thread producer([&queue]()
+    {
+        int batch[7];
+        for (int i = 0; i < count;)
+        {
+            if (i % 3 == 0)
+            {
+                queue.push(i++);
+                continue;
+            }
+
+            const int batchSize = std::min(7, count - i);
+            std::iota(batch, batch + batchSize, i);
+            i += int(queue.try_push_n(batch, batchSize));
+        }
+    });
+
+    // Size can be read by any thread, it must never exceed the capacity
+    std::atomic<bool> finished = false;
+    std::atomic<int> invalidSizes = 0;
+    std::thread observer([&queue, &finished, &invalidSizes]()
+    {
+        while (!finished.load())
+        {
+            if (queue.size() > queue.capacity())
+            {
+                ++invalidSizes;
+            }
+        }
+    });
+
+    std::vector<int> values;
+    values.reserve(count);
+
+    while (values.size() < size_t(count))
+    {
+        int value = 0;
+        if (values.size() % 2 == 0 && queue.try_pop(value))
+        {
+            values.push_back(value);
+        }
+        else
+        {
+            int batch[5];
+            const size_t popped = queue.try_pop_n(batch, 5);
+            values.insert(values.end(), batch, batch + popped);
+
+            if (popped == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    producer.join();
+    finished.store(true);
+    observer.join();
+    CHECK_EQ(invalidSizes.load(), 0);
+
+    std::vector<int> expected(count);
+    std::iota(expected.begin(), expected.end(), 0);
+    CHECK(values == expected);
+    CHECK(queue.empty());
+}
+
+TEST_SUITE_END();
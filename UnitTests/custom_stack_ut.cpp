@@ -19,8 +19,15 @@
 
 #include "doctest.h"
 #include "custom_stack.h"
+#include "custom_list.h"
 
 #include <stack>
+#include <string>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <numeric>
+#include <algorithm>
 
 void test_stack_equality(const course_l01::stack<int>& v1, const std::stack<int>& v2)
 {
@@ -118,3 +125,111 @@ TEST_CASE("[stack] swap stacks")
 
     test_stack_equality(stack3, stack4);
 }
+
+TEST_CASE("[stack] list container")
+{
+    course_l01::stack<int, course_l01::list<int>> stack1;
+    std::stack<int> stack2;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        stack1.push(i);
+        stack2.push(i);
+
+        if (i % 3 == 2)
+        {
+            stack1.pop();
+            stack2.pop();
+        }
+
+        CHECK_EQ(stack1.size(), stack2.size());
+        CHECK_EQ(stack1.top(), stack2.top());
+    }
+}
+
+TEST_CASE("[lockfree_stack] single thread")
+{
+    course_l01::lockfree_stack<std::string> stack1;
+    CHECK(stack1.empty());
+
+    std::string value;
+    CHECK_FALSE(stack1.try_pop(value));
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        stack1.push(std::to_string(i));
+    }
+
+    stack1.emplace(3, 'x');
+    CHECK_FALSE(stack1.empty());
+
+    CHECK(stack1.try_pop(value));
+    CHECK_EQ(value, "xxx");
+
+    for (int i = 999; i >= 0; --i)
+    {
+        REQUIRE(stack1.try_pop(value));
+        CHECK_EQ(value, std::to_string(i));
+    }
+
+    CHECK_FALSE(stack1.try_pop(value));
+    CHECK(stack1.empty());
+
+    // Items left in the stack are destroyed with it
+    course_l01::lockfree_stack<std::shared_ptr<int>> stack2;
+    auto pointer = std::make_shared<int>(1);
+    stack2.push(pointer);
+    stack2.push(pointer);
+    CHECK_EQ(pointer.use_count(), 3);
+}
+
+TEST_CASE("[lockfree_stack] concurrent push and pop")
+{
+    constexpr int threadCount = 8;
+    constexpr int itemsPerThread = 20000;
+    course_l01::lockfree_stack<int> stack1;
+
+    // Threads push their items and pop items of any thread, like
+    // threads sharing a free list. Every item must be popped once.
+    std::vector<std::vector<int>> popped(threadCount);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&stack1, &values = popped[t], t]()
+        {
+            for (int i = 0; i < itemsPerThread; ++i)
+            {
+                stack1.push(t * itemsPerThread + i);
+
+                int value = 0;
+                if (i % 3 != 0 && stack1.try_pop(value))
+                {
+                    values.push_back(value);
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<int> values;
+    for (const std::vector<int>& threadValues : popped)
+    {
+        values.insert(values.end(), threadValues.begin(), threadValues.end());
+    }
+
+    int value = 0;
+    while (stack1.try_pop(value))
+    {
+        values.push_back(value);
+    }
+
+    std::sort(values.begin(), values.end());
+    std::vector<int> expected(threadCount * itemsPerThread);
+    std::iota(expected.begin(), expected.end(), 0);
+    CHECK(values == expected);
+}
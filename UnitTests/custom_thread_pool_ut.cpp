@@ -0,0 +1,140 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+
+#include "custom_thread_pool.h"
+#include "doctest.h"
+
+#include <vector>
+#include <atomic>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+
+long long parallel_fib(course_l01::thread_pool& pool, int n)
+{
+    if (n < 12)
+    {
+        return n < 2 ? n : parallel_fib(pool, n - 1) + parallel_fib(pool, n - 2);
+    }
+
+    long long a = 0;
+    course_l01::task_group group(pool);
+    group.run([&pool, &a, n]() { a = parallel_fib(pool, n - 1); });
+    const long long b = parallel_fib(pool, n - 2);
+    group.wait();
+    return a + b;
+}
+
+template<typename Iterator>
+void parallel_sort(course_l01::thread_pool& pool, Iterator begin, Iterator end)
+{
+    if (end - begin < 1000)
+    {
+        std::sort(begin, end);
+        return;
+    }
+
+    Iterator middle = begin + (end - begin) / 2;
+    course_l01::task_group group(pool);
+    group.run([&pool, begin, middle]() { parallel_sort(pool, begin, middle); });
+    group.run([&pool, middle, end]() { parallel_sort(pool, middle, end); });
+    group.wait();
+    std::inplace_merge(begin, middle, end);
+}
+
+}   // namespace
+
+TEST_SUITE_BEGIN("thread_pool");
+
+TEST_CASE("[thread_pool] fork join")
+{
+    for (std::size_t threadCount : { 1, 2, 4 })
+    {
+        course_l01::thread_pool pool(threadCount);
+        CHECK_EQ(pool.thread_count(), threadCount);
+        CHECK_EQ(parallel_fib(pool, 25), 75025);
+
+        std::vector<int> values(100000);
+        std::iota(values.rbegin(), values.rend(), 0);
+        parallel_sort(pool, values.begin(), values.end());
+        CHECK(std::is_sorted(values.begin(), values.end()));
+    }
+}
+
+TEST_CASE("[thread_pool] many tasks")
+{
+    course_l01::thread_pool pool(3);
+    std::atomic<int> sum = 0;
+
+    // More tasks than the capacity of the queue for outside tasks
+    course_l01::task_group group(pool);
+    for (int i = 0; i < 10000; ++i)
+    {
+        group.run([&sum, i]() { sum += i; });
+    }
+
+    group.wait();
+    CHECK_EQ(sum.load(), 10000 * 9999 / 2);
+
+    // Submitted tasks run without a group
+    std::atomic<int> count = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        pool.submit([&count]() { ++count; });
+    }
+
+    while (count.load() < 100)
+    {
+        std::this_thread::yield();
+    }
+}
+
+TEST_CASE("[thread_pool] exception")
+{
+    course_l01::thread_pool pool(2);
+    std::atomic<int> count = 0;
+
+    course_l01::task_group group(pool);
+    for (int i = 0; i < 100; ++i)
+    {
+        group.run([&count, i]()
+        {
+            ++count;
+            if (i % 10 == 0)
+            {
+                throw std::runtime_error("task failed");
+            }
+        });
+    }
+
+    // All tasks are finished, first exception is rethrown
+    CHECK_THROWS_AS(group.wait(), std::runtime_error);
+    CHECK_EQ(count.load(), 100);
+
+    // Group can be used again
+    group.run([&count]() { ++count; });
+    group.wait();
+    CHECK_EQ(count.load(), 101);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,392 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+#include "custom_unrolled_list.h"
+#include "custom_pool_allocator.h"
+#include "doctest.h"
+
+#include <list>
+#include <string>
+#include <random>
+#include <memory_resource>
+#include <algorithm>
+
+template<typename T, std::size_t BlockSize>
+void test_unrolled_list_equality(const course_l01::unrolled_list<T, BlockSize>& v1, const std::list<T>& v2)
+{
+    CHECK_EQ(v1.empty(), v2.empty());
+    CHECK_EQ(v1.size(), v2.size());
+    CHECK_EQ(std::distance(v1.begin(), v1.end()), std::distance(v2.begin(), v2.end()));
+
+    CHECK(std::equal(v1.begin(), v1.end(), v2.begin(), v2.end()));
+    CHECK(std::equal(v1.cbegin(), v1.cend(), v2.cbegin(), v2.cend()));
+    CHECK(std::equal(v1.rbegin(), v1.rend(), v2.rbegin(), v2.rend()));
+
+    // Blocks are never empty
+    CHECK_LE(v1.block_count(), v1.size());
+    CHECK_GE(v1.block_count() * v1.block_size(), v1.size());
+}
+
+TEST_SUITE_BEGIN("unrolled_list");
+
+TEST_CASE("[unrolled_list] constructors")
+{
+    std::list<int> list2 = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+    course_l01::unrolled_list<int, 4> list1 = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    test_unrolled_list_equality(list1, list2);
+    CHECK_EQ(list1.block_count(), 3);
+
+    course_l01::unrolled_list<int, 4> list3(list1);
+    test_unrolled_list_equality(list3, list2);
+
+    course_l01::unrolled_list<int, 4> list4(std::move(list3));
+    test_unrolled_list_equality(list4, list2);
+    CHECK(list3.empty());
+
+    course_l01::unrolled_list<int, 4> list5(list2.begin(), list2.end());
+    test_unrolled_list_equality(list5, list2);
+
+    course_l01::unrolled_list<int, 4> list6(5);
+    test_unrolled_list_equality(list6, std::list<int>(5));
+
+    list6 = list1;
+    test_unrolled_list_equality(list6, list2);
+
+    list6.assign({ 1, 2 });
+    test_unrolled_list_equality(list6, std::list<int>{ 1, 2 });
+
+    list6 = std::move(list5);
+    test_unrolled_list_equality(list6, list2);
+}
+
+TEST_CASE("[unrolled_list] push and pop")
+{
+    course_l01::unrolled_list<std::string, 4> list1;
+    std::list<std::string> list2;
+
+    for (int i = 0; i < 50; ++i)
+    {
+        list1.push_back(std::to_string(i));
+        list2.push_back(std::to_string(i));
+        list1.push_front(std::to_string(-i));
+        list2.push_front(std::to_string(-i));
+    }
+
+    test_unrolled_list_equality(list1, list2);
+    CHECK_EQ(list1.front(), list2.front());
+    CHECK_EQ(list1.back(), list2.back());
+
+    while (list1.size() > 3)
+    {
+        list1.pop_back();
+        list2.pop_back();
+        list1.pop_front();
+        list2.pop_front();
+        CHECK_EQ(list1.front(), list2.front());
+        CHECK_EQ(list1.back(), list2.back());
+    }
+
+    test_unrolled_list_equality(list1, list2);
+}
+
+TEST_CASE("[unrolled_list] insert and erase")
+{
+    std::mt19937 generator(17);
+
+    course_l01::unrolled_list<std::string, 8> list1;
+    std::list<std::string> list2;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        const size_t position = list2.empty() ? 0 : generator() % (list2.size() + 1);
+        auto it1 = std::next(list1.begin(), position);
+        auto it2 = std::next(list2.begin(), position);
+
+        switch (generator() % 5)
+        {
+            case 0:
+            case 1:
+            case 2:
+            {
+                it1 = list1.insert(it1, std::to_string(i));
+                it2 = list2.insert(it2, std::to_string(i));
+                CHECK_EQ(*it1, *it2);
+                break;
+            }
+
+            case 3:
+            {
+                if (it2 != list2.end())
+                {
+                    it1 = list1.erase(it1);
+                    it2 = list2.erase(it2);
+                    CHECK_EQ(it1 == list1.end(), it2 == list2.end());
+                }
+                break;
+            }
+
+            case 4:
+            {
+                const size_t count = std::min<size_t>(generator() % 6, std::distance(it2, list2.end()));
+                it1 = list1.erase(it1, std::next(it1, count));
+                it2 = list2.erase(it2, std::next(it2, count));
+                CHECK_EQ(std::distance(list1.begin(), it1), std::distance(list2.begin(), it2));
+                break;
+            }
+        }
+    }
+
+    test_unrolled_list_equality(list1, list2);
+    REQUIRE_GE(list2.size(), 10);
+
+    list1.insert(std::next(list1.begin(), 5), 10, "x");
+    list2.insert(std::next(list2.begin(), 5), 10, "x");
+    test_unrolled_list_equality(list1, list2);
+
+    std::vector<std::string> items = { "a", "b", "c", "d", "e", "f", "g" };
+    list1.insert(std::next(list1.begin(), 3), items.begin(), items.end());
+    list2.insert(std::next(list2.begin(), 3), items.begin(), items.end());
+    test_unrolled_list_equality(list1, list2);
+
+    // Insert of own item
+    list1.insert(list1.begin(), list1.back());
+    list2.insert(list2.begin(), list2.back());
+    test_unrolled_list_equality(list1, list2);
+
+    list1.resize(5);
+    list2.resize(5);
+    test_unrolled_list_equality(list1, list2);
+
+    list1.clear();
+    CHECK(list1.empty());
+    CHECK_EQ(list1.block_count(), 0);
+}
+
+TEST_CASE("[unrolled_list] insert item of the same full block")
+{
+    // Items of the second half of the full block are moved by
+    // the split, the inserted value must be created before it.
+    course_l01::unrolled_list<std::string, 4> list1 = { "first item", "second item", "third item", "fourth item" };
+    std::list<std::string> list2 = { "first item", "second item", "third item", "fourth item" };
+    CHECK_EQ(list1.block_count(), 1);
+
+    list1.insert(list1.begin(), *std::next(list1.begin(), 3));
+    list2.insert(list2.begin(), *std::next(list2.begin(), 3));
+    test_unrolled_list_equality(list1, list2);
+
+    list1.push_back("fifth item");
+    list2.push_back("fifth item");
+    list1.push_back("sixth item");
+    list2.push_back("sixth item");
+    auto it1 = std::prev(list1.end(), 4);
+    auto it2 = std::prev(list2.end(), 4);
+    list1.emplace(it1, *std::prev(list1.end()));
+    list2.emplace(it2, *std::prev(list2.end()));
+    test_unrolled_list_equality(list1, list2);
+}
+
+TEST_CASE("[unrolled_list] splice")
+{
+    std::mt19937 generator(5);
+
+    course_l01::unrolled_list<int, 4> list1;
+    course_l01::unrolled_list<int, 4> list2;
+    std::list<int> list3;
+    std::list<int> list4;
+
+    for (int i = 0; i < 40; ++i)
+    {
+        list1.push_back(i);
+        list3.push_back(i);
+        list2.push_back(100 + i);
+        list4.push_back(100 + i);
+    }
+
+    for (int i = 0; i < 500; ++i)
+    {
+        const size_t position = generator() % (list3.size() + 1);
+        auto pos1 = std::next(list1.begin(), position);
+        auto pos3 = std::next(list3.begin(), position);
+
+        size_t first = list4.empty() ? 0 : generator() % list4.size();
+        size_t last = first + (list4.empty() ? 0 : generator() % (list4.size() - first + 1));
+
+        switch (generator() % 3)
+        {
+            case 0:
+                list1.splice(pos1, list2, std::next(list2.begin(), first), std::next(list2.begin(), last));
+                list3.splice(pos3, list4, std::next(list4.begin(), first), std::next(list4.begin(), last));
+                break;
+
+            case 1:
+                if (!list4.empty())
+                {
+                    list1.splice(pos1, list2, std::next(list2.begin(), first));
+                    list3.splice(pos3, list4, std::next(list4.begin(), first));
+                }
+                break;
+
+            case 2:
+                if (position < list3.size())
+                {
+                    // Move the tail of the list to the front
+                    list1.splice(list1.begin(), list1, pos1, list1.end());
+                    list3.splice(list3.begin(), list3, pos3, list3.end());
+                }
+                break;
+        }
+
+        std::swap(list1, list2);
+        std::swap(list3, list4);
+    }
+
+    test_unrolled_list_equality(list1, list3);
+    test_unrolled_list_equality(list2, list4);
+
+    list1.splice(std::next(list1.begin(), list1.size() / 2), list2);
+    list3.splice(std::next(list3.begin(), list3.size() / 2), list4);
+    test_unrolled_list_equality(list1, list3);
+    test_unrolled_list_equality(list2, list4);
+
+    list1.splice(list1.begin(), list1, std::prev(list1.end()));
+    list3.splice(list3.begin(), list3, std::prev(list3.end()));
+    test_unrolled_list_equality(list1, list3);
+
+    list1.splice(list1.begin(), list1, list1.begin());
+    list3.splice(list3.begin(), list3, list3.begin());
+    test_unrolled_list_equality(list1, list3);
+}
+
+TEST_CASE("[unrolled_list] splice between different pool resources")
+{
+    using allocator = course_l01::pool_allocator<std::string>;
+    using pooled_list = course_l01::unrolled_list<std::string, 4, allocator>;
+
+    pooled_list list1({ "a", "b", "c", "d", "e" }, allocator(std::make_shared<course_l01::pool_resource>()));
+    std::list<std::string> list2 = { "a", "b", "c", "d", "e" };
+    {
+        // Items are moved, blocks of the other list stay in its pool,
+        // which is released together with the other list.
+        pooled_list list3({ "f", "g", "h", "i", "j", "k" }, allocator(std::make_shared<course_l01::pool_resource>()));
+        CHECK(list1.get_allocator() != list3.get_allocator());
+
+        list1.splice(std::next(list1.begin()), list3, std::next(list3.begin()), std::prev(list3.end()));
+        list2.splice(std::next(list2.begin()), std::list<std::string>{ "g", "h", "i", "j" });
+        CHECK_EQ(list3.size(), 2);
+
+        list1.splice(list1.end(), list3, list3.begin());
+        list2.push_back("f");
+        list1.splice(list1.begin(), list3);
+        list2.push_front("k");
+        CHECK(list3.empty());
+    }
+
+    CHECK_EQ(list1.size(), list2.size());
+    CHECK(std::equal(list1.begin(), list1.end(), list2.begin(), list2.end()));
+}
+
+TEST_CASE("[unrolled_list] operations")
+{
+    std::mt19937 generator(11);
+
+    course_l01::unrolled_list<int, 5> list1;
+    std::list<int> list2;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        const int value = generator() % 50;
+        list1.push_back(value);
+        list2.push_back(value);
+    }
+
+    list1.sort(std::greater<int>());
+    list2.sort(std::greater<int>());
+    test_unrolled_list_equality(list1, list2);
+
+    CHECK_EQ(list1.unique(), 950);
+    list2.unique();
+    test_unrolled_list_equality(list1, list2);
+
+    list1.reverse();
+    list2.reverse();
+    test_unrolled_list_equality(list1, list2);
+
+    course_l01::unrolled_list<int, 5> list3 = { 3, 10, 17, 25, 33, 60 };
+    std::list<int> list4 = { 3, 10, 17, 25, 33, 60 };
+    list1.merge(list3);
+    list2.merge(list4);
+    test_unrolled_list_equality(list1, list2);
+    CHECK(list3.empty());
+
+    const size_t removed = list2.size();
+    list2.remove_if([](int value) { return value % 2 == 0; });
+    CHECK_EQ(list1.remove([](int value) { return value % 2 == 0; }), removed - list2.size());
+    test_unrolled_list_equality(list1, list2);
+
+    CHECK_EQ(list1.remove(33), 2);
+    list2.remove(33);
+    test_unrolled_list_equality(list1, list2);
+
+    list1.swap(list3);
+    CHECK(list1.empty());
+    CHECK_EQ(list3.size(), list2.size());
+}
+
+TEST_CASE("[unrolled_list] allocator constructs items")
+{
+    // Items are constructed by the allocator, so polymorphic
+    // allocator passes its memory resource to the strings.
+    std::pmr::monotonic_buffer_resource resource;
+    using allocator = std::pmr::polymorphic_allocator<std::pmr::string>;
+
+    course_l01::unrolled_list<std::pmr::string, 4, allocator> list1(&resource);
+    for (int i = 0; i < 10; ++i)
+    {
+        list1.emplace_back(40, char('a' + i));
+        list1.emplace_front(40, char('A' + i));
+    }
+
+    list1.insert(std::next(list1.begin(), 3), std::pmr::string(40, 'x'));
+    list1.erase(std::next(list1.begin(), 5));
+
+    CHECK_EQ(list1.size(), 20);
+    for (const std::pmr::string& item : list1)
+    {
+        CHECK_EQ(item.get_allocator().resource(), &resource);
+    }
+}
+
+TEST_CASE("[unrolled_list] merge into existing blocks")
+{
+    course_l01::unrolled_list<int, 4> list1 = { 1, 3, 5, 7, 9, 11, 13, 15 };
+    course_l01::unrolled_list<int, 4> list2 = { 0, 2, 4, 16, 17, 18, 19, 20, 21 };
+    std::list<int> list3 = { 1, 3, 5, 7, 9, 11, 13, 15 };
+    std::list<int> list4 = { 0, 2, 4, 16, 17, 18, 19, 20, 21 };
+
+    // Items, which are not moved by the insertion, stay in their blocks
+    const int* address = &list1.back();
+    list1.merge(list2);
+    list3.merge(list4);
+    test_unrolled_list_equality(list1, list3);
+    CHECK(list2.empty());
+    CHECK_EQ(&*std::find(list1.begin(), list1.end(), 15), address);
+}
+
+TEST_SUITE_END();
@@ -21,6 +21,8 @@
 #include "doctest.h"
 
 #include <vector>
+#include <memory_resource>
+#include <sstream>
 
 template<typename T1, typename T2>
 void test_iterator_equality(T1 it1, T1 it1End, T2 it2, T2 it2End)
@@ -52,6 +54,52 @@ void test_vector_equality(const course_l01::vector<int>& v1, const std::vector<i
     test_iterator_equality(v1.crbegin(), v1.crend(), v2.crbegin(), v2.crend());
 }
 
+template<typename T>
+class PropagatingAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    PropagatingAllocator(int id = 0) : m_id(id) { }
+    template<typename U>
+    PropagatingAllocator(const PropagatingAllocator<U>& other) : m_id(other.get_id()) { }
+
+    T* allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+    void deallocate(T* p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+
+    int get_id() const { return m_id; }
+
+    bool operator==(const PropagatingAllocator& other) const { return m_id == other.m_id; }
+    bool operator!=(const PropagatingAllocator& other) const { return m_id != other.m_id; }
+
+private:
+    int m_id = 0;
+};
+
+class RelocatableInt
+{
+public:
+    RelocatableInt(int v) : m_value(std::make_unique<int>(v)) { }
+    RelocatableInt(const RelocatableInt& other) : m_value(std::make_unique<int>(other.get_value())) { }
+    RelocatableInt(RelocatableInt&& other) : m_value(std::move(other.m_value)) { ++s_moveCalls; }
+
+    RelocatableInt& operator=(RelocatableInt&& other) { m_value = std::move(other.m_value); return *this; }
+
+    int get_value() const { return *m_value; }
+
+    static int get_move_calls() { return s_moveCalls; }
+
+private:
+    inline static int s_moveCalls = 0;
+    std::unique_ptr<int> m_value;
+};
+
+template<>
+struct course_l01::is_trivially_relocatable<RelocatableInt> : std::true_type { };
+
 TEST_SUITE_BEGIN("vector");
 
 TEST_CASE("[vector] default constructor")
@@ -147,6 +195,46 @@ TEST_CASE("[vector] assign")
     test_vector_equality(vector1, vector2);
 }
 
+TEST_CASE("[vector] assignment reuses capacity")
+{
+    course_l01::vector<int> vector1 = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    course_l01::vector<int> vector3 = { 10, 11, 12 };
+    std::vector<int> vector2 = { 10, 11, 12 };
+
+    const int* data = vector1.data();
+
+    vector1 = vector3;
+    CHECK_EQ(vector1.data(), data);
+    test_vector_equality(vector1, vector2);
+
+    vector1.assign(6, 9);
+    vector2.assign(6, 9);
+    CHECK_EQ(vector1.data(), data);
+    test_vector_equality(vector1, vector2);
+
+    vector1.assign({ 20, 21 });
+    vector2.assign({ 20, 21 });
+    CHECK_EQ(vector1.data(), data);
+    test_vector_equality(vector1, vector2);
+
+    std::istringstream stream1("30 31 32 33");
+    std::istringstream stream2("30 31 32 33");
+    vector1.assign(std::istream_iterator<int>(stream1), std::istream_iterator<int>());
+    vector2.assign(std::istream_iterator<int>(stream2), std::istream_iterator<int>());
+    CHECK_EQ(vector1.data(), data);
+    test_vector_equality(vector1, vector2);
+
+    std::istringstream stream3("40");
+    std::istringstream stream4("40");
+    vector1.assign(std::istream_iterator<int>(stream3), std::istream_iterator<int>());
+    vector2.assign(std::istream_iterator<int>(stream4), std::istream_iterator<int>());
+    test_vector_equality(vector1, vector2);
+
+    vector1.assign(20, vector1.front());
+    vector2.assign(20, vector2.front());
+    test_vector_equality(vector1, vector2);
+}
+
 TEST_CASE("[vector] operator[]")
 {
     course_l01::vector<int> vector1 = { 1, 2, 3, 4, 5 };
@@ -236,6 +324,31 @@ TEST_CASE("[vector] resize")
     test_vector_equality(vector1, vector2);
 }
 
+TEST_CASE("[vector] resize_default_init/append_uninitialized")
+{
+    course_l01::vector<char> vector1 = { 'a', 'b' };
+    std::vector<char> vector2 = { 'a', 'b', 'c', 'd', 'e' };
+
+    char* data = vector1.append_uninitialized(3);
+    CHECK_EQ(data, vector1.data() + 2);
+    CHECK_EQ(vector1.size(), 5);
+    std::copy(vector2.begin() + 2, vector2.end(), data);
+    test_iterator_equality(vector1.begin(), vector1.end(), vector2.begin(), vector2.end());
+
+    vector1.resize_default_init(100);
+    CHECK_EQ(vector1.size(), 100);
+    test_iterator_equality(vector1.begin(), vector1.begin() + 5, vector2.begin(), vector2.end());
+
+    vector1.resize_default_init(2);
+    vector2.resize(2);
+    test_iterator_equality(vector1.begin(), vector1.end(), vector2.begin(), vector2.end());
+
+    course_l01::vector<std::vector<int>> vector3;
+    vector3.resize_default_init(3);
+    CHECK_EQ(vector3.size(), 3);
+    CHECK(vector3[2].empty());
+}
+
 TEST_CASE("[vector] clear")
 {
     course_l01::vector<int> vector1 = { 1, 2, 3, 4, 5 };
@@ -360,6 +473,43 @@ TEST_CASE("[vector] insert")
     CHECK_EQ(std::distance(it1, vector1.end()), std::distance(it2, vector2.end()));
 }
 
+TEST_CASE("[vector] insert input iterator")
+{
+    course_l01::vector<int> vector1 = { 1, 2, 3 };
+    std::vector<int> vector2 = { 1, 2, 3 };
+
+    std::istringstream stream1("4 5 6 7");
+    std::istringstream stream2("4 5 6 7");
+    auto it1 = vector1.insert(std::next(vector1.begin()), std::istream_iterator<int>(stream1), std::istream_iterator<int>());
+    auto it2 = vector2.insert(std::next(vector2.begin()), std::istream_iterator<int>(stream2), std::istream_iterator<int>());
+    test_vector_equality(vector1, vector2);
+    CHECK_EQ(std::distance(it1, vector1.end()), std::distance(it2, vector2.end()));
+
+    std::istringstream stream3("8 9");
+    std::istringstream stream4("8 9");
+    it1 = vector1.insert(vector1.end(), std::istream_iterator<int>(stream3), std::istream_iterator<int>());
+    it2 = vector2.insert(vector2.end(), std::istream_iterator<int>(stream4), std::istream_iterator<int>());
+    test_vector_equality(vector1, vector2);
+    CHECK_EQ(std::distance(it1, vector1.end()), std::distance(it2, vector2.end()));
+}
+
+TEST_CASE("[vector] insert own element")
+{
+    course_l01::vector<int> vector1 = { 1, 2, 3 };
+    std::vector<int> vector2 = { 1, 2, 3 };
+
+    vector1.shrink_to_fit();
+    vector2.shrink_to_fit();
+
+    vector1.insert(vector1.begin(), 5, vector1.back());
+    vector2.insert(vector2.begin(), 5, vector2.back());
+    test_vector_equality(vector1, vector2);
+
+    vector1.insert(vector1.begin(), vector1[6]);
+    vector2.insert(vector2.begin(), vector2[6]);
+    test_vector_equality(vector1, vector2);
+}
+
 TEST_CASE("[vector] erase single")
 {
     course_l01::vector<int> vector1 = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
@@ -436,6 +586,28 @@ TEST_CASE("[vector] erase multi")
     test_vector_equality(vector1, vector2);
 }
 
+TEST_CASE("[vector] remove/remove_if")
+{
+    course_l01::vector<int> vector1 = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 3 };
+    std::vector<int> vector2 = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 3 };
+
+    auto isOdd = [](int value) { return value % 2 == 1; };
+
+    CHECK_EQ(vector1.remove(3), 2);
+    vector2.erase(std::remove(vector2.begin(), vector2.end(), 3), vector2.end());
+    test_vector_equality(vector1, vector2);
+
+    CHECK_EQ(vector1.remove_if(isOdd), 5);
+    vector2.erase(std::remove_if(vector2.begin(), vector2.end(), isOdd), vector2.end());
+    test_vector_equality(vector1, vector2);
+
+    CHECK_EQ(course_l01::erase_if(vector1, [](int value) { return value > 6; }), 3);
+    CHECK_EQ(course_l01::erase(vector1, 4), 1);
+    CHECK_EQ(vector1.remove(100), 0);
+    vector2 = { 2, 6 };
+    test_vector_equality(vector1, vector2);
+}
+
 TEST_CASE("[vector] emlace/emplace_back")
 {
     course_l01::vector<int> vector1;
@@ -490,4 +662,165 @@ TEST_CASE("[vector] emlace/emplace_back")
     test_vector_equality(vector3, vector4);
 }
 
+TEST_CASE("[vector] pmr allocator")
+{
+    std::pmr::monotonic_buffer_resource resource;
+    std::vector<int> vector2 = { 1, 2, 3, 4, 5 };
+
+    course_l01::pmr::vector<int> vector1(&resource);
+    vector1.insert(vector1.end(), vector2.begin(), vector2.end());
+
+    CHECK_EQ(vector1.get_allocator().resource(), &resource);
+    test_iterator_equality(vector1.begin(), vector1.end(), vector2.begin(), vector2.end());
+
+    // Allocator of the polymorphic vector is never propagated
+    course_l01::pmr::vector<int> vector3;
+    vector3 = vector1;
+    CHECK_NE(vector3.get_allocator().resource(), &resource);
+    test_iterator_equality(vector3.begin(), vector3.end(), vector2.begin(), vector2.end());
+
+    // Moving into a vector with different resource must move the elements
+    course_l01::pmr::vector<int> vector4(std::move(vector1), vector3.get_allocator());
+    CHECK_EQ(vector4.get_allocator(), vector3.get_allocator());
+    test_iterator_equality(vector4.begin(), vector4.end(), vector2.begin(), vector2.end());
+
+    // Moving into a vector with the same resource takes the storage
+    course_l01::pmr::vector<int> vector5(vector3.get_allocator());
+    const int* data = vector3.data();
+    vector5 = std::move(vector3);
+    CHECK_EQ(vector5.data(), data);
+    CHECK(vector3.empty());
+}
+
+TEST_CASE("[vector] allocator propagation")
+{
+    using vector_type = course_l01::vector<int, PropagatingAllocator<int>>;
+    std::vector<int> vector2 = { 1, 2, 3, 4, 5 };
+
+    vector_type vector1(vector2.begin(), vector2.end(), PropagatingAllocator<int>(1));
+    vector_type vector3(PropagatingAllocator<int>(2));
+
+    vector3 = vector1;
+    CHECK_EQ(vector3.get_allocator().get_id(), 1);
+    test_iterator_equality(vector3.begin(), vector3.end(), vector2.begin(), vector2.end());
+
+    vector_type vector4(PropagatingAllocator<int>(3));
+    vector4 = std::move(vector3);
+    CHECK_EQ(vector4.get_allocator().get_id(), 1);
+    test_iterator_equality(vector4.begin(), vector4.end(), vector2.begin(), vector2.end());
+
+    vector_type vector5(PropagatingAllocator<int>(4));
+    vector5.swap(vector4);
+    CHECK_EQ(vector5.get_allocator().get_id(), 1);
+    CHECK_EQ(vector4.get_allocator().get_id(), 4);
+    test_iterator_equality(vector5.begin(), vector5.end(), vector2.begin(), vector2.end());
+}
+
+TEST_CASE("[vector] trivially relocatable")
+{
+    static_assert(course_l01::is_trivially_relocatable_v<int>);
+    static_assert(!course_l01::is_trivially_relocatable_v<std::vector<int>>);
+    static_assert(course_l01::is_trivially_relocatable_v<RelocatableInt>);
+
+    course_l01::vector<RelocatableInt> vector1;
+    const int moveCalls = RelocatableInt::get_move_calls();
+
+    for (int i = 0; i < 100; ++i)
+    {
+        vector1.push_back(RelocatableInt(i));
+    }
+
+    vector1.erase(std::next(vector1.begin(), 10), vector1.end());
+    vector1.shrink_to_fit();
+
+    // Elements were moved only into the vector by push_back, reallocations
+    // of the vector's storage have just copied the bytes.
+    CHECK_EQ(RelocatableInt::get_move_calls() - moveCalls, 100);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        CHECK_EQ(vector1[i].get_value(), i);
+    }
+}
+
+TEST_CASE("[vector] growth policy")
+{
+    course_l01::vector<int, std::allocator<int>, course_l01::doubling_growth_policy> vector1;
+    course_l01::vector<int, std::allocator<int>, course_l01::one_and_half_growth_policy> vector2;
+    course_l01::vector<int, std::allocator<int>, course_l01::size_class_growth_policy> vector3;
+    std::vector<int> vector4;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        vector1.push_back(i);
+        vector2.push_back(i);
+        vector3.push_back(i);
+        vector4.push_back(i);
+    }
+
+    CHECK_EQ(vector1.capacity(), 1024);
+    CHECK_GE(vector2.capacity(), 1000);
+    CHECK_LT(vector2.capacity(), 1500);
+    CHECK_GE(vector3.capacity(), 1000);
+    CHECK_EQ(vector3.capacity() * sizeof(int) % 16, 0);
+
+    test_iterator_equality(vector1.begin(), vector1.end(), vector4.begin(), vector4.end());
+    test_iterator_equality(vector2.begin(), vector2.end(), vector4.begin(), vector4.end());
+    test_iterator_equality(vector3.begin(), vector3.end(), vector4.begin(), vector4.end());
+
+    CHECK_EQ(course_l01::size_class_growth_policy::round_to_size_class(1), 16);
+    CHECK_EQ(course_l01::size_class_growth_policy::round_to_size_class(100), 112);
+    CHECK_EQ(course_l01::size_class_growth_policy::round_to_size_class(129), 160);
+    CHECK_EQ(course_l01::size_class_growth_policy::round_to_size_class(1000), 1024);
+    CHECK_EQ(course_l01::size_class_growth_policy::round_to_size_class(1025), 1280);
+
+    // Shrinking uses the growth policy and does not reallocate,
+    // if the policy would choose the same capacity.
+    const int* data1 = vector1.data();
+    vector1.shrink_to_fit();
+    CHECK_EQ(vector1.capacity(), 1024);
+    CHECK_EQ(vector1.data(), data1);
+
+    vector2.shrink_to_fit();
+    CHECK_EQ(vector2.capacity(), 1000);
+    const int* data2 = vector2.data();
+    vector2.shrink_to_fit();
+    CHECK_EQ(vector2.data(), data2);
+
+    vector3.shrink_to_fit();
+    CHECK_EQ(vector3.capacity(), 1024);
+    const int* data3 = vector3.data();
+    vector3.shrink_to_fit();
+    CHECK_EQ(vector3.data(), data3);
+
+    test_iterator_equality(vector1.begin(), vector1.end(), vector4.begin(), vector4.end());
+    test_iterator_equality(vector2.begin(), vector2.end(), vector4.begin(), vector4.end());
+    test_iterator_equality(vector3.begin(), vector3.end(), vector4.begin(), vector4.end());
+}
+
+TEST_CASE("[vector] aligned allocator")
+{
+    course_l01::aligned_vector<float, 32> vector1;
+    std::vector<float> vector2;
+
+    CHECK_EQ(vector1.alignment, 32);
+    CHECK_EQ(course_l01::vector<double>::alignment, alignof(double));
+    CHECK_EQ(vector1.aligned_data(), nullptr);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        vector1.push_back(float(i));
+        vector2.push_back(float(i));
+
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(vector1.data()) % 32, 0);
+        CHECK_EQ(vector1.aligned_data(), vector1.data());
+    }
+
+    test_iterator_equality(vector1.begin(), vector1.end(), vector2.begin(), vector2.end());
+
+    course_l01::aligned_vector<float, 64> vector3(vector2.begin(), vector2.end());
+    CHECK_EQ(reinterpret_cast<std::uintptr_t>(vector3.data()) % 64, 0);
+    test_iterator_equality(vector3.begin(), vector3.end(), vector2.begin(), vector2.end());
+}
+
 TEST_SUITE_END();
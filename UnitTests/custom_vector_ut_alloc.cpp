@@ -218,6 +218,34 @@ TEST_CASE("[vector] assign")
     CHECK_EQ(TestInt::get_constructor_calls(), TestInt::get_destructor_calls());
 }
 
+TEST_CASE("[vector] assignment reuses capacity")
+{
+    {
+        course_l01::vector<TestInt> vector1 = { 1, 2, 3, 4, 5 };
+        course_l01::vector<TestInt> vector3 = { 6, 7, 8 };
+        std::vector<TestInt> vector2 = { 6, 7, 8 };
+
+        const TestInt* data = vector1.data();
+        const int constructorCalls = TestInt::get_constructor_calls();
+
+        // Items are assigned, no new item is constructed
+        vector1 = vector3;
+        CHECK_EQ(vector1.data(), data);
+        CHECK_EQ(TestInt::get_constructor_calls(), constructorCalls);
+        test_vector_equality(vector1, vector2);
+
+        vector1 = course_l01::vector<TestInt>({ 1, 2, 3, 4, 5, 6, 7 });
+        vector2 = { 1, 2, 3, 4, 5, 6, 7 };
+        test_vector_equality(vector1, vector2);
+
+        vector3 = vector1;
+        test_vector_equality(vector3, vector2);
+    }
+
+    CHECK(TestInt::is_none_instance_existing());
+    CHECK_EQ(TestInt::get_constructor_calls(), TestInt::get_destructor_calls());
+}
+
 TEST_CASE("[vector] operator[]")
 {
     {
@@ -332,6 +360,25 @@ TEST_CASE("[vector] resize")
     CHECK_EQ(TestInt::get_constructor_calls(), TestInt::get_destructor_calls());
 }
 
+TEST_CASE("[vector] resize constructs in place")
+{
+    {
+        course_l01::vector<TestInt> vector1;
+        vector1.reserve(10);
+
+        const int constructorCalls = TestInt::get_constructor_calls();
+        vector1.resize(10);
+        CHECK_EQ(TestInt::get_constructor_calls() - constructorCalls, 10);
+
+        vector1.resize_default_init(15);
+        CHECK_EQ(vector1.size(), 15);
+        CHECK_EQ(vector1[14].get_value(), 0);
+    }
+
+    CHECK(TestInt::is_none_instance_existing());
+    CHECK_EQ(TestInt::get_constructor_calls(), TestInt::get_destructor_calls());
+}
+
 TEST_CASE("[vector] clear")
 {
     {
@@ -536,6 +583,20 @@ TEST_CASE("[vector] erase multi")
     CHECK_EQ(TestInt::get_constructor_calls(), TestInt::get_destructor_calls());
 }
 
+TEST_CASE("[vector] remove_if")
+{
+    {
+        course_l01::vector<TestInt> vector1 = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+        std::vector<TestInt> vector2 = { 2, 4, 6, 8, 10, 12 };
+
+        CHECK_EQ(vector1.remove_if([](const TestInt& value) { return value.get_value() % 2 == 1; }), 6);
+        test_vector_equality(vector1, vector2);
+    }
+
+    CHECK(TestInt::is_none_instance_existing());
+    CHECK_EQ(TestInt::get_constructor_calls(), TestInt::get_destructor_calls());
+}
+
 TEST_CASE("[vector] emlace/emplace_back")
 {
     {
@@ -0,0 +1,132 @@
+//
+// (c) Jakub Melka 2023
+//
+// This source file is part of the licensed software between Jakub Melka
+// and the users utilizing the software under the specified License Agreement.
+// Usage of this source code is subject to the Software License Agreement.
+//
+// This source code is provided solely for educational, research, or teaching purposes,
+// including paid ones. Licensee may modify, adapt, and create derivative works,
+// but all modifications must be released as Public Domain or under a license having
+// the same legal effect as publishing as Public Domain under US jurisdiction.
+//
+// The Software is provided "as is," without warranty of any kind. Licensor shall not be liable
+// for any damages arising from the use or performance of this source code.
+//
+// Ownership and intellectual property rights to this source code remain with Licensor.
+// It is important for the Licensee to read and understand the complete Software License Agreement.
+//
+
+
+#include "custom_work_stealing_deque.h"
+#include "doctest.h"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <numeric>
+#include <algorithm>
+
+TEST_SUITE_BEGIN("work_stealing_deque");
+
+TEST_CASE("[work_stealing_deque] owner and thief ends")
+{
+    course_l01::work_stealing_deque<int> deque(4);
+    CHECK_EQ(deque.capacity(), 4);
+    CHECK(deque.empty());
+
+    int value = 0;
+    CHECK_FALSE(deque.pop(value));
+    CHECK_FALSE(deque.steal(value));
+
+    // Deque grows, when it is full
+    for (int i = 0; i < 10; ++i)
+    {
+        deque.push(i);
+    }
+
+    CHECK_EQ(deque.size(), 10);
+    CHECK_EQ(deque.capacity(), 16);
+
+    // Owner takes the newest item, thief the oldest one
+    CHECK(deque.pop(value));
+    CHECK_EQ(value, 9);
+    CHECK(deque.steal(value));
+    CHECK_EQ(value, 0);
+    CHECK(deque.steal(value));
+    CHECK_EQ(value, 1);
+
+    std::vector<int> values;
+    while (deque.pop(value))
+    {
+        values.push_back(value);
+    }
+
+    CHECK_EQ(values, std::vector<int>{ 8, 7, 6, 5, 4, 3, 2 });
+    CHECK(deque.empty());
+}
+
+TEST_CASE("[work_stealing_deque] thieves")
+{
+    constexpr int thiefCount = 3;
+    constexpr int itemCount = 100000;
+    course_l01::work_stealing_deque<int> deque(8);
+    std::atomic<bool> done = false;
+
+    std::vector<std::vector<int>> stolen(thiefCount);
+    std::vector<std::thread> thieves;
+
+    for (int t = 0; t < thiefCount; ++t)
+    {
+        thieves.emplace_back([&deque, &done, &values = stolen[t]]()
+        {
+            int value = 0;
+            while (!done.load(std::memory_order_acquire) || !deque.empty())
+            {
+                if (deque.steal(value))
+                {
+                    values.push_back(value);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Owner pushes items and pops some of them, while the thieves steal
+    std::vector<int> values;
+    for (int i = 0; i < itemCount; ++i)
+    {
+        deque.push(i);
+
+        int value = 0;
+        if (i % 4 == 0 && deque.pop(value))
+        {
+            values.push_back(value);
+        }
+    }
+
+    done.store(true, std::memory_order_release);
+
+    for (std::thread& thief : thieves)
+    {
+        thief.join();
+    }
+
+    for (const std::vector<int>& thiefValues : stolen)
+    {
+        // Thief steals items in the order they were pushed
+        CHECK(std::is_sorted(thiefValues.begin(), thiefValues.end()));
+        values.insert(values.end(), thiefValues.begin(), thiefValues.end());
+    }
+
+    // Every item is taken exactly once
+    std::sort(values.begin(), values.end());
+    std::vector<int> expected(itemCount);
+    std::iota(expected.begin(), expected.end(), 0);
+    CHECK(values == expected);
+}
+
+TEST_SUITE_END();